@@ -38,6 +38,9 @@
 #define NUM_IRQS		128
 #define SPURIOUS_BIT	0x80
 
+/* software interrupt to force a kernel re-entry (EMUINT, otherwise unused) */
+#define REENTRY_IRQ		0
+
 
 /** default interrupt handler */
 __cold void board_unhandled_irq_handler(unsigned int irq)
@@ -103,6 +106,8 @@ __init void intc_init(void)
 	intc_write(INTC_MIR_SET(2), 0xffffffff);
 	intc_write(INTC_MIR_SET(3), 0xffffffff);
 
+	board_irq_enable(REENTRY_IRQ);
+
 	/* allow all interrupts */
 	intc_write(INTC_THRESHOLD, 0x7f);
 }
@@ -133,6 +138,12 @@ void board_irq_enable(unsigned int irq)
 	intc_write(INTC_MIR_CLEAR(word), 1u << bit);
 }
 
+/** force a kernel re-entry: raise the software interrupt */
+void board_kernel_reentry(void)
+{
+	intc_write(INTC_ISR_SET(REENTRY_IRQ / 32), 1u << (REENTRY_IRQ % 32));
+}
+
 /** dispatch IRQ: mask and ack, call handler */
 void board_irq_dispatch(unsigned int vector __unused)
 {
@@ -140,7 +151,10 @@ void board_irq_dispatch(unsigned int vector __unused)
 
 	irq = intc_read(INTC_SIR_IRQ);
 
-	if (irq < NUM_IRQS) {
+	if (irq == REENTRY_IRQ) {
+		/* kernel re-entry: clear software interrupt */
+		intc_write(INTC_ISR_CLEAR(REENTRY_IRQ / 32), 1u << (REENTRY_IRQ % 32));
+	} else if (irq < NUM_IRQS) {
 		/* device interrupt: call handler, will mask interrupt if necessary */
 		isr_cfg[irq].func(isr_cfg[irq].arg0);
 	} else {
@@ -270,6 +270,12 @@ void board_irq_enable(unsigned int irq)
 	dist_write32(DIST_ENABLE + 4 * word, 1u << bit);
 }
 
+/** force a kernel re-entry: send an SGI to the current processor */
+void board_kernel_reentry(void)
+{
+	dist_write32(DIST_IPI, IPI_SELF_ONLY | IRQ_ID_REENTRY);
+}
+
 /** dispatch IRQ: mask and ack, call handler */
 /* NOTE: vector is an IDT entry number, but IRQs start from vector 0x20 on! */
 void board_irq_dispatch(unsigned int vector __unused)
@@ -281,7 +287,9 @@ void board_irq_dispatch(unsigned int vector __unused)
 		val = gic_read32(GIC_ACK);
 
 		irq = val & VALID_IRQ_MASK;
-		if (irq < 32) {
+		if (irq == IRQ_ID_REENTRY) {
+			/* kernel re-entry, nothing to do */
+		} else if (irq < 32) {
 			/* per CPU interrupts, never masked, directly call handler */
 			isr_cfg[irq].func((void*)SENDER_CPU(val));
 		} else if (irq == VALID_IRQ_MASK) {
@@ -10,3 +10,6 @@ ELF_LOADADDR = 0x00000000
 
 # bsp specific targets to run / debug
 BSPTARGETS=run debug autorun
+
+# the startup code unpacks a compressed kernel .data image
+ROM_COMPRESS_KERNEL = yes
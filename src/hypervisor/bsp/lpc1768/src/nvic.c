@@ -95,6 +95,10 @@ void board_irq_dispatch(unsigned int vector __unused)
 {
 	unsigned int irq;
 
+	if (vector == 14) {
+		/* PendSV: kernel re-entry, nothing to do */
+		return;
+	}
 	if (vector == 15) {
 		nvic_timer_handler(vector);
 		return;
@@ -107,6 +111,12 @@ void board_irq_dispatch(unsigned int vector __unused)
 	isr_cfg[irq].func(isr_cfg[irq].arg0);
 }
 
+/** force a kernel re-entry: set PendSV pending */
+void board_kernel_reentry(void)
+{
+	ICSR = ICSR_PENDSVSET;
+}
+
 void board_unhandled_irq_handler(unsigned int irq)
 {
 	hm_system_error(HM_ERROR_UNHANDLED_IRQ, irq);
@@ -24,6 +24,9 @@
 #define IRQ_ID_SPURIOUS		0xffff
 #define IRQ_ID_MASK			0xffff
 
+/* software interrupt to force a kernel re-entry (KLDDs use sources 4 to 7) */
+#define IRQ_ID_REENTRY		0
+
 /* register definitions for INTC */
 #define IRQ_INTC_MCR		(*((volatile unsigned int *) 0xFFF48000u))
 #define IRQ_INTC_CPR_PRC0	(*((volatile unsigned int *) 0xFFF48008u))
@@ -63,8 +66,13 @@ static void irq_INTC_dispatch(void)
 	/* reading the source number also acknowledges the interrupt */
 	irq = IRQ_IACKR_INTVEC(IRQ_INTC_IACKR_PRC0);
 
-	/* call handler, CPR is still 1 - no other interrupts allowed */
-	isr_cfg[irq].func(isr_cfg[irq].arg0);
+	if (irq == IRQ_ID_REENTRY) {
+		/* kernel re-entry: nothing to do */
+		IRQ_INTC_SSCIR(IRQ_ID_REENTRY) = IRQ_SSCIR_CLR;
+	} else {
+		/* call handler, CPR is still 1 - no other interrupts allowed */
+		isr_cfg[irq].func(isr_cfg[irq].arg0);
+	}
 
 	/* handler finished - either the interrupt was handled or it has been masked.
 	 * now we can lower CPR again */
@@ -85,6 +93,8 @@ __init void board_intc_init(void)
 {
 	printf("INTC supports %u IRQs\n", NUM_IRQS);
 	IRQ_INTC_CPR_PRC0 = 0;
+
+	board_irq_enable(IRQ_ID_REENTRY);
 }
 
 /** mask IRQ in distributor */
@@ -122,6 +132,12 @@ void board_irq_dispatch(unsigned int vector)
 	}
 }
 
+/** force a kernel re-entry: raise the software interrupt */
+void board_kernel_reentry(void)
+{
+	IRQ_INTC_SSCIR(IRQ_ID_REENTRY) = IRQ_SSCIR_SET;
+}
+
 /* "magic marker" for KLDD functions */
 unsigned int board_irq_kldd_magic;
 
@@ -19,6 +19,7 @@ unsigned int board_putc(int c);
 
 /* cache.c */
 void board_cache_init(void);
+void board_dcache_enable(void);
 
 /* board.c */
 void board_halt(haltmode_t mode);
@@ -67,6 +67,15 @@
 #define INTC_SOURCE_SSCIR5     (5u)
 #define INTC_SOURCE_SSCIR6     (6u)
 
+/* Sources of software interrupts to force a kernel re-entry on the own CPU,
+ * one per CPU. */
+
+#define INTC_SOURCE_SSCIR8     (8u)
+#define INTC_SOURCE_SSCIR9     (9u)
+#define INTC_SOURCE_SSCIR10    (10u)
+
+#define INTC_SOURCE_REENTRY(cpu) (INTC_SOURCE_SSCIR8 + (cpu))
+
 #define IRQ_SSCIR_SET           0x02u
 #define IRQ_SSCIR_CLR           0x01u
 
@@ -28,7 +28,7 @@
  *            | region | usage                                         |
  *            +--------------------------------------------------------+
  *            | 0      |supervisor has all rights over flash           |
- *            | 1      |supervisor has all rights over peripherals     |
+ *            | 1      |supervisor all rights, peripherals, uncached   |
  *            | 2 - 15 |generated rights for user partitions           |
  *            +--------------------------------------------------------+
  *            +--------------------------------------------------------+
@@ -47,19 +47,19 @@
  *            +--------------------------------------------------------+
  *            | region  | usage                                        |
  *            +--------------------------------------------------------+
- *            | 0       |kernel global data, read only                 |
- *            | 1       |kernel data on CPU0, write for supervisor     |
+ *            | 0       |kernel shared data, supervisor, uncached      |
+ *            | 1       |RAM of CPU0, write for supervisor on CPU0     |
  *            | 2 - 5   |partition data on CPU0, generated rights      |
- *            | 6       |kernel data on CPU1, write for supervisor     |
+ *            | 6       |RAM of CPU1, write for supervisor on CPU1     |
  *            | 7 - 10  |partition data on CPU1, generated rights      |
- *            | 11      |kernel data on CPU1, write for supervisor     |
+ *            | 11      |RAM of CPU2, write for supervisor on CPU2     |
  *            | 12 - 15 |partition data on CPU1, generated rights      |
  *            +--------------------------------------------------------+
  *            +--------------------------------------------------------+
  *            | NvM and peripherals protection (SMPU0)                 |
  *            +--------------------------------------------------------+
  *            | 0       |supervisor all writes over flash              |
- *            | 1       |supervisor all writes peripheral space        |
+ *            | 1       |supervisor all writes peripherals, uncached   |
  *            | 2 - 5   |generated user partition rights on CPU0       |
  *            | 7 - 10  |generated user partition rights on CPU1       |
  *            | 12 - 15 |generated user partition rights on CPU2       |
@@ -209,6 +209,9 @@
  * That is, all 16 MxS fields (2 bit each) get the value 1. */
 #define SMPU_ALL_POINT_ACCSET1 (0x55555555u)
 
+/* Point all bus masters to ACCSET2 in word 3. */
+#define SMPU_ALL_POINT_ACCSET2 (0xAAAAAAAAu)
+
 #if (defined SMP)
 /* Values of word 3 (access pointer) when each CPU points to ACCSET1 and all
  * others point to nothing (no rights) */
@@ -217,6 +220,13 @@
 #define SMPU_CPU1_POINTS_ACCSET1    (0x10000000u)
 #define SMPU_CPU2_POINTS_ACCSET1    (0x04000000u)
 
+/* Values of word 3 when each CPU points to ACCSET1 and all other bus masters
+ * point to ACCSET2 */
+
+#define SMPU_CPU0_ACCSET1_OTHERS_ACCSET2    (0x6AAAAAAAu)
+#define SMPU_CPU1_ACCSET1_OTHERS_ACCSET2    (0x9AAAAAAAu)
+#define SMPU_CPU2_ACCSET1_OTHERS_ACCSET2    (0xA6AAAAAAu)
+
 #endif
 
 /*------------------[Word 3]--------------------------------------------------*/
@@ -257,6 +267,13 @@
 /* Access rights are defined in Word 3 in the ACCSET fiels. */
 #define SMPU_WRD3_FMT1            (0x10u)
 
+/* Cache inhibit bit (CI).
+ * Accesses hitting this region bypass the data cache of the e200z4 cores.
+ * If several regions match an access, the access is cache-inhibited if any
+ * of them has CI set. Note that the attribute is only applied when the SMPU
+ * is enabled. */
+#define SMPU_WRD3_CI              (0x01u)
+
 /*------------------[Word 5]--------------------------------------------------*/
 /**
  * \brief SMPU x, Region Descriptor n, Word 5.
@@ -434,6 +434,15 @@ void __init board_secondary_cpu_up(unsigned int cpu)
     assert(cpu == arch_cpu_id());
     board_cpus_online |= (1u << cpu);
 
+#if (defined USE_MPU)
+    /* wait until CPU0 has enabled the SMPU with its cache-inhibited regions */
+    while ((SMPU_1_CES0 & SMPU_CES0_ENABLE) == 0)
+    {
+        /* wait */
+    }
+    board_dcache_enable();
+#endif
+
     /* serve core watchdogs ... */
 }
 #endif
@@ -454,6 +463,11 @@ void __init board_startup_complete(void)
     SMPU_1_CES0 = SMPU_CES0_ENABLE;
     /* enable the flash and peripherals SMPU */
     SMPU_0_CES0 = SMPU_CES0_ENABLE;
+
+#if (defined USE_MPU)
+    /* shared kernel data and peripherals are cache-inhibited now */
+    board_dcache_enable();
+#endif
 #endif
 }
 
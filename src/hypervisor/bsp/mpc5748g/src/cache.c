@@ -10,15 +10,55 @@
 #include <ppc_insn.h>
 #include <ppc_spr.h>
 #include <board_stuff.h>
+#include "stm.h"
 
 
 #define CACHE_LINE_SIZE 32
 
+/* contents of L1CSR0 register */
+#define CACHE_L1CSR0_DCE    0x01
+#define CACHE_L1CSR0_DCINV  0x02
+#define CACHE_L1CSR0_DCABT  0x04
+
 /* contents of L1CSR1 register */
 #define CACHE_L1CSR1_ICE    0x01
 #define CACHE_L1CSR1_ICINV  0x02
 #define CACHE_L1CSR1_ICABT  0x04
 
+#ifdef VERBOSE
+/* memory loop for the cache benchmark, half the size of the 4K data cache */
+#define CACHE_BENCH_WORDS   512
+#define CACHE_BENCH_PASSES  64
+
+/* the benchmark runs on CPU0 and uses STM_0 */
+#define CACHE_BENCH_STM(reg) MEMORY_WORD(STM_BASE + (reg))
+
+/* kept in the private data of CPU0, the shared kernel data is uncached */
+static unsigned int cache_bench_buf[CACHE_BENCH_WORDS] __section_bss_core(0);
+
+/** sum up the benchmark buffer a number of times, return the STM ticks */
+static unsigned int __init cache_bench_run(void)
+{
+    volatile unsigned int *p = cache_bench_buf;
+    unsigned int start;
+    unsigned int sum = 0;
+    unsigned int pass;
+    unsigned int i;
+
+    start = CACHE_BENCH_STM(STM_CNT);
+    for (pass = 0; pass < CACHE_BENCH_PASSES; pass++)
+    {
+        for (i = 0; i < CACHE_BENCH_WORDS; i++)
+        {
+            sum += p[i];
+        }
+    }
+    cache_bench_buf[0] = sum;
+
+    return CACHE_BENCH_STM(STM_CNT) - start;
+}
+#endif
+
 void __init board_cache_init(void)
 {
     unsigned int cpu_id = arch_cpu_id();
@@ -46,3 +86,75 @@ void __init board_cache_init(void)
         ppc_set_spr(SPR_L1CSR1, CACHE_L1CSR1_ICE);
     }
 }
+
+/*
+ * The data cache is enabled separately: the e200z4 cores take the
+ * cache-inhibit attribute of an access from the SMPU, so the SMPU must be
+ * set up and enabled before, otherwise peripheral registers and data shared
+ * between the CPUs would be cached. The cache operates in copy-back mode.
+ */
+void __init board_dcache_enable(void)
+{
+    unsigned int cpu_id = arch_cpu_id();
+#ifdef VERBOSE
+    unsigned int stm_cr = 0;
+    unsigned int ticks_off = 0;
+    unsigned int ticks_on;
+#endif
+
+    /* again, no cache for CPU2 */
+    if (cpu_id >= CPU2)
+    {
+        return;
+    }
+
+#ifdef VERBOSE
+    if (cpu_id == CPU0)
+    {
+        /* let the STM count while measuring if it is not yet running */
+        stm_cr = CACHE_BENCH_STM(STM_CR);
+        if ((stm_cr & STM_CR_TEN) == 0)
+        {
+            CACHE_BENCH_STM(STM_CR) = STM_CR_TEN;
+        }
+        ticks_off = cache_bench_run();
+    }
+#endif
+
+    /* invalidate cache entries */
+    ppc_sync();
+    ppc_set_spr(SPR_L1CSR0, CACHE_L1CSR0_DCINV);
+
+    while ( (ppc_get_spr(SPR_L1CSR0) & CACHE_L1CSR0_DCINV) != 0)
+    {
+        /* wait */
+    }
+
+    while ( (ppc_get_spr(SPR_L1CSR0) & CACHE_L1CSR0_DCABT) != 0)
+    {
+        /* cache operation aborted - something's horribly wrong - loop forever */
+    }
+
+    /* enable cache */
+    ppc_set_spr(SPR_L1CSR0, CACHE_L1CSR0_DCE);
+    ppc_isync();
+
+#ifdef VERBOSE
+    if (cpu_id == CPU0)
+    {
+        /* first run warms up the cache */
+        cache_bench_run();
+        ticks_on = cache_bench_run();
+
+        if ((stm_cr & STM_CR_TEN) == 0)
+        {
+            /* leave the STM stopped and cleared for stm_release_all() */
+            CACHE_BENCH_STM(STM_CR) = stm_cr;
+            CACHE_BENCH_STM(STM_CNT) = 0;
+        }
+
+        Vprintf("D-cache enabled, memory loop: %u ticks uncached, %u ticks cached\n",
+                ticks_off, ticks_on);
+    }
+#endif
+}
@@ -108,6 +108,13 @@ static void irq_INTC_dispatch(void)
             kernel_ipi_handle(cpu_id, CPU2);
             break;
 #endif
+        /* Software interrupts (kernel re-entry) */
+        case INTC_SOURCE_SSCIR8:
+        case INTC_SOURCE_SSCIR9:
+        case INTC_SOURCE_SSCIR10:
+            IRQ_INTC_SSCIR(irq) = IRQ_SSCIR_CLR;
+            assert(irq == INTC_SOURCE_REENTRY(arch_cpu_id()));
+            break;
         /* STM */
         case INTC_SOURCE_STM_0_CIR0:
         case INTC_SOURCE_STM_1_CIR0:
@@ -179,6 +186,9 @@ __init void board_intc_init(void)
     }
 #endif
 
+    /* the software interrupt to re-enter the kernel is private to each CPU */
+    board_irq_enable(INTC_SOURCE_REENTRY(arch_cpu_id()));
+
     printf("INTC supports %u IRQs\n", NUM_IRQS);
     intc_write_cpr(0);
 }
@@ -234,6 +244,12 @@ void board_irq_dispatch(unsigned int vector)
     }
 }
 
+/** force a kernel re-entry: raise the software interrupt of the own CPU */
+void board_kernel_reentry(void)
+{
+    IRQ_INTC_SSCIR(INTC_SOURCE_REENTRY(arch_cpu_id())) = IRQ_SSCIR_SET;
+}
+
 /* "magic marker" for KLDD functions */
 unsigned int board_irq_kldd_magic;
 
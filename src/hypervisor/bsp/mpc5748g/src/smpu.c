@@ -25,6 +25,7 @@
 
 #include <kernel.h> /* arch_cpu_id */
 #include <board.h>  /* declaration of board_mpu_init */
+#include <board_stuff.h> /* board_dcache_enable */
 #include "smpu.h"
 #include <stdint.h> /* uint32_t */
 
@@ -35,6 +36,10 @@
 /*==================[external constants]======================================*/
 /*==================[internal constants]======================================*/
 /*==================[external data]===========================================*/
+
+/* end of the kernel data shared between the CPUs, defined in kernel.ld */
+extern char __shared_end[];
+
 /*==================[internal data]===========================================*/
 /*==================[external function definitions]===========================*/
 
@@ -62,40 +67,45 @@ void board_mpu_init(void)
 
         /*----------- RAM protecttion ----------------------------------------*/
 
-        /* The supervisor has read access for entire RAM on all CPUs.
-         * This is necessary when reading global data, mostly configuration data
-         * and internal data structures.
-         * Writable data is located in memory segments allocated to each CPU and
-         * defined in the linker file.
+        /* The cores do not snoop each other's data caches. The kernel's
+         * global data and the per-core data accessed by other cores (core,
+         * scheduler and time partition state, partition state, IPI queues)
+         * are collected at the start of the RAM up to __shared_end by the
+         * linker file. This area is cache-inhibited and writable by the
+         * supervisor on all CPUs, as there is no region left to separate
+         * the data of the individual cores.
          */
 
-        accset1 = ACCSET_S_READ;
+        accset1 = (ACCSET_S_READ | ACCSET_S_WRITE);
 
-        region.start_address  = BOARD_RAM_BEGIN;
-        region.end_address    = BOARD_RAM_END;
+        region.start_address   = BOARD_RAM_BEGIN;
+        region.end_address     = (uint32_t)__shared_end - 1u;
         region.access_pointers = SMPU_ALL_POINT_ACCSET1;
-        region.permissions     = SMPU_WRD3_MAKE_ACCSET1(accset1) | SMPU_WRD3_FMT1;
+        region.permissions     = SMPU_WRD3_MAKE_ACCSET1(accset1) | SMPU_WRD3_FMT1 |
+                                 SMPU_WRD3_CI;
         smpu_write_region(SMPU1, 0, &region);
 
-        /* Write access for for every CPU in its own RAM segment. Reading is
-         * done through region 0. */
+        /* The remaining RAM segment of every CPU is cached. The supervisor
+         * of the owning CPU may write to it, the other CPUs only read
+         * configuration data and static task attributes. Shared memories
+         * are cache-inhibited in their generated partition regions. */
 
-        accset1 = (ACCSET_S_WRITE);
+        region.permissions     = SMPU_WRD3_MAKE_ACCSET1(ACCSET_S_READ | ACCSET_S_WRITE) |
+                                 SMPU_WRD3_MAKE_ACCSET2(ACCSET_S_READ) | SMPU_WRD3_FMT1;
 
         region.start_address   = RAM_BEGIN_CPU0;
         region.end_address     = RAM_END_CPU0;
-        region.access_pointers = SMPU_CPU0_POINTS_ACCSET1;
-        region.permissions     = SMPU_WRD3_MAKE_ACCSET1(accset1) | SMPU_WRD3_FMT1;
+        region.access_pointers = SMPU_CPU0_ACCSET1_OTHERS_ACCSET2;
         smpu_write_region(SMPU1, 1, &region);
 
         region.start_address   = RAM_BEGIN_CPU1;
         region.end_address     = RAM_END_CPU1;
-        region.access_pointers = SMPU_CPU1_POINTS_ACCSET1;
+        region.access_pointers = SMPU_CPU1_ACCSET1_OTHERS_ACCSET2;
         smpu_write_region(SMPU1, 6, &region);
 
         region.start_address   = RAM_BEGIN_CPU2;
         region.end_address     = RAM_END_CPU2;
-        region.access_pointers = SMPU_CPU2_POINTS_ACCSET1;
+        region.access_pointers = SMPU_CPU2_ACCSET1_OTHERS_ACCSET2;
         smpu_write_region(SMPU1, 11, &region);
 
         /*----------- Flash protecttion --------------------------------------*/
@@ -118,10 +128,12 @@ void board_mpu_init(void)
 
         region.start_address   = BOARD_PERIPHERAL_BEGIN;
         region.end_address     = BOARD_PERIPHERAL_END;
+        region.permissions     = SMPU_WRD3_MAKE_ACCSET1(accset1) | SMPU_WRD3_FMT1 |
+                                 SMPU_WRD3_CI;
         smpu_write_region(SMPU0, 1, &region);
 
         /* The SMPU is enabled when all initialization has completed in function
-         * board_startup_complete */
+         * board_startup_complete. The data caches are enabled afterwards. */
     }
 
   #else /* Single core */
@@ -148,17 +160,26 @@ void board_mpu_init(void)
 
         region.start_address   = BOARD_PERIPHERAL_BEGIN;
         region.end_address     = BOARD_PERIPHERAL_END;
+        region.permissions     = SMPU_WRD3_MAKE_ACCSET1(accset1) | SMPU_WRD3_FMT1 |
+                                 SMPU_WRD3_CI;
         smpu_write_region(SMPU0, 1, &region);
 
         /*----------- RAM protecttion ----------------------------------------*/
 
+        /* RAM is cached. Shared memories with an uncached policy get the
+         * CI bit in their generated partition regions. */
+
         region.start_address   = BOARD_RAM_BEGIN;
         region.end_address     = BOARD_RAM_END;
+        region.permissions     = SMPU_WRD3_MAKE_ACCSET1(accset1) | SMPU_WRD3_FMT1;
         smpu_write_region(SMPU1, 0, &region);
 
         /* enable SMPU */
         SMPU_0_CES0 = SMPU_CES0_ENABLE;
         SMPU_1_CES0 = SMPU_CES0_ENABLE;
+
+        /* peripherals are cache-inhibited now, turn on the data cache */
+        board_dcache_enable();
     }
   #endif /* if (defined SMP) */
 
@@ -15,6 +15,7 @@
 #define IRQ_ID_STOP			0
 #define IRQ_ID_IPI			1
 #define IRQ_ID_IPI_TIMER	2
+#define IRQ_ID_REENTRY		3
 
 #define IRQ_ID_GTIMER		27
 #define IRQ_ID_LEGACY_FIQ	28
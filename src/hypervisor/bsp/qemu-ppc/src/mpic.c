@@ -133,6 +133,10 @@ __init void mpic_enable(void)
 	/* use 0xffff as spurious vector */
 	mpic_write(MPIC_SVR, IRQ_ID_SPURIOUS);
 
+	/* IPI 0 (kernel re-entry): unmasked, priority 1, IPI vector */
+	mpic_write(MPIC_IPIPR0, (1u << 16) | IRQ_ID_IPI);
+	mpic_write(MPIC_CTPR, 0);
+
 
 #if 0
 	/* FIXME: IMPLEMENT! */
@@ -172,6 +176,12 @@ void board_irq_enable(unsigned int irq)
 	(void)irq;
 }
 
+/** force a kernel re-entry: send IPI 0 to the current processor */
+void board_kernel_reentry(void)
+{
+	mpic_write(MPIC_IPIDR0, 1u << arch_cpu_id());
+}
+
 /** dispatch IRQ: mask and ack, call handler */
 void board_irq_dispatch(unsigned int vector)
 {
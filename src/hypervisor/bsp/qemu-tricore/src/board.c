@@ -137,6 +137,7 @@ void __init board_init(void)
 		tc_irq_setup_all();
 		stm_timer_init(100);
 	}
+	board_irq_enable(TC_IRQ_REENTRY);
 
 	/* enter the kernel */
 	/* NOTE: all processors take the same entry point! */
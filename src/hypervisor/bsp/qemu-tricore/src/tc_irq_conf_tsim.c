@@ -10,12 +10,12 @@
 
 /* IRQ config for TSIM */
 const struct tc_irq tc_irq_table_cpu0[24] = {
-	/* The first two entries are unused for CPUs:
-	 * priority #0 can never receive an interrupt, and
-	 * priority #1 is usually used for rescheduling.
+	/* Priority #0 can never receive an interrupt,
+	 * priority #1 forces a kernel re-entry (TC_IRQ_REENTRY).
 	 */
 	TC_IRQ_ENTRY(0x00000000,   0, SRC_TOS_CPU0),
-	TC_IRQ_ENTRY(0x00000000,   1, SRC_TOS_CPU0),
+	/* CPU_SRC0, CPU software service request 0 */
+	TC_IRQ_ENTRY(0xf7e0fffc,   1, SRC_TOS_CPU0),
 	/* STM Timer #0 at 0xf0000000 */
 	TC_IRQ_ENTRY(0xf00000fc,   2, SRC_TOS_CPU0),
 	TC_IRQ_ENTRY(0x00000000,   3, SRC_TOS_CPU0),
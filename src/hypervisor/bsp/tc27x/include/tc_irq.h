@@ -196,4 +196,10 @@ void tc_irq_setup(const struct tc_irq_table *table);
 /** Setup all interrupt tables. */
 void tc_irq_setup_all(void);
 
+/** Interrupt priority to force a kernel re-entry, see the interrupt tables. */
+#define TC_IRQ_REENTRY      1
+
+/** Handler of the kernel re-entry interrupt. */
+void tc_irq_reentry_handler(unsigned int irq);
+
 #endif
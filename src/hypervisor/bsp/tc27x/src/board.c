@@ -106,6 +106,7 @@ void __init board_init(void)
 #ifdef SMP
     stm_timer_init_core(cpu_id);
 #endif
+    board_irq_enable(TC_IRQ_REENTRY);
 
     /* enter the kernel */
     /* NOTE: all processors take the same entry point! */
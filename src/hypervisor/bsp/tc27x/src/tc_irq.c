@@ -40,6 +40,23 @@ void board_irq_disable(unsigned int irq_id)
     tc_irq_disable(entry);
 }
 
+/** force a kernel re-entry: set the request flag of the re-entry interrupt */
+void board_kernel_reentry(void)
+{
+    const struct tc_irq *entry;
+
+    entry = tc_irq_get_entry(arch_cpu_id(), TC_IRQ_REENTRY);
+    assert(entry != NULL);
+    assert(entry->src != NULL);
+
+    tc_irq_setr(entry);
+}
+
+/** kernel re-entry interrupt: nothing to do, the request flag is cleared */
+void tc_irq_reentry_handler(unsigned int irq __unused)
+{
+}
+
 __cold void board_unhandled_irq_handler(unsigned int irq_id)
 {
     hm_system_error(HM_ERROR_UNHANDLED_IRQ, irq_id);
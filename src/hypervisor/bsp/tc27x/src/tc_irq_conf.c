@@ -12,12 +12,12 @@
 /* IRQ config for TSIM */
 const struct tc_irq tc_irq_table_cpu0[24] =
 {
-    /* The first two entries are unused for CPUs:
-     * priority #0 can never receive an interrupt, and
-     * priority #1 is usually used for rescheduling.
+    /* Priority #0 can never receive an interrupt,
+     * priority #1 forces a kernel re-entry (TC_IRQ_REENTRY).
      */
     TC_IRQ_ENTRY(0x00000000,   0, SRC_TOS_CPU0),
-    TC_IRQ_ENTRY(0x00000000,   1, SRC_TOS_CPU0),
+    /* SRC_GPSR00, General Purpose Service Request 0 of group 0 */
+    TC_IRQ_ENTRY(0xF0038990,   1, SRC_TOS_CPU0),
     /* SRC_STM0SR0, System Timer 0 Service Request 0 */
     TC_IRQ_ENTRY(0xF0038490,   2, SRC_TOS_CPU0),
     /* ASCLIN 0 Transmit Service Request */
@@ -49,7 +49,8 @@ const struct tc_irq tc_irq_table_cpu0[24] =
 const struct tc_irq tc_irq_table_cpu1[24] =
 {
     TC_IRQ_ENTRY(0x00000000,   0, SRC_TOS_CPU1),
-    TC_IRQ_ENTRY(0x00000000,   1, SRC_TOS_CPU1),
+    /* SRC_GPSR10, General Purpose Service Request 0 of group 1 */
+    TC_IRQ_ENTRY(0xF00389B0,   1, SRC_TOS_CPU1),
     /* System Timer 1 Service Request 0,
      * offset 0x0490 + (0x01 * 0x08) */
     TC_IRQ_ENTRY(0xF0038498,   2, SRC_TOS_CPU1),
@@ -81,7 +82,8 @@ const struct tc_irq tc_irq_table_cpu1[24] =
 const struct tc_irq tc_irq_table_cpu2[24] =
 {
     TC_IRQ_ENTRY(0x00000000,   0, SRC_TOS_CPU2),
-    TC_IRQ_ENTRY(0x00000000,   1, SRC_TOS_CPU2),
+    /* SRC_GPSR20, General Purpose Service Request 0 of group 2 */
+    TC_IRQ_ENTRY(0xF00389D0,   1, SRC_TOS_CPU2),
     /* System Timer 2 Service Request 0
      * offset 0x0490 + (0x02 * 0x08) */
     TC_IRQ_ENTRY(0xF00384A0,   2, SRC_TOS_CPU2),
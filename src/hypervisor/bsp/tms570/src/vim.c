@@ -22,6 +22,12 @@
 /* we support 95 possible IRQ vectors */
 #define NUM_IRQS 95
 
+/* system software interrupt (SSI) to force a kernel re-entry */
+#define SSI_IRQ		21
+#define SYS_SSIR1	0xffffffb0	/* SSI request 1, write key and data */
+#define SYS_SSIVEC	0xfffffff4	/* SSI vector, reading clears the request */
+#define SSIR_KEY	0x7500
+
 struct vim {
 	/* 0xdec -- SRAM parity management */
 	uint32_t parflg;
@@ -119,11 +125,23 @@ void board_irq_dispatch(unsigned int vector __unused)
 	irq--;
 	assert(irq < NUM_IRQS);
 
+	if (irq == SSI_IRQ) {
+		/* kernel re-entry: nothing to do */
+		(void)readl((volatile void *)SYS_SSIVEC);
+		return;
+	}
+
 	/* call handler */
 	isr_cfg[irq].func(isr_cfg[irq].arg0);
 }
 
+/** force a kernel re-entry: raise the system software interrupt */
+void board_kernel_reentry(void)
+{
+	writel((volatile void *)SYS_SSIR1, SSIR_KEY);
+}
+
 __init void vim_irq_init(void)
 {
-	/* empty */
+	board_irq_enable(SSI_IRQ);
 }
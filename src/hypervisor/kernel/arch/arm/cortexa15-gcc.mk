@@ -18,8 +18,10 @@ ARCH_AFLAGS += $(_ARCH_MCPU) -DARM_MMU -DARM_CORTEXA15 -DARM_VFP32
 # for relocatable linking
 ARCH_LDFLAGS := $(call ld-option,-marmelf,-marmelf_linux_eabi)
 
-ARCH_MODS := entry exception mmu
+ARCH_MODS := entry exception mmu cache
 ARCH_MODS_SMP :=
+# sampling profiler (PROFILE=yes) supported
+ARCH_PROFILE := yes
 
 
 # Recommended user compiler and linker flags
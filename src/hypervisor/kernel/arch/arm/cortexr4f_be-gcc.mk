@@ -18,8 +18,10 @@ ARCH_AFLAGS += $(_ARCH_MCPU) -DARM_MPU_12 -DARM_VFP16 -mfpu=vfpv3-d16
 # for relocatable linking
 ARCH_LDFLAGS := $(call ld-option,-marmelfb,-marmelfb_linux_eabi) -EB
 
-ARCH_MODS := entry exception mpu
+ARCH_MODS := entry exception mpu cache
 ARCH_MODS_SMP :=
+# sampling profiler (PROFILE=yes) supported
+ARCH_PROFILE := yes
 
 
 # Recommended user compiler and linker flags
@@ -19,6 +19,7 @@
 #include <arm_private.h>
 #include <arm_cr.h>
 #include <arm_insn.h>
+#include <arm_perf.h>
 #include <sched_state.h>
 
 
@@ -261,6 +262,14 @@ static inline void arch_reg_frame_set_return(struct arch_reg_frame *regs, unsign
 	regs->regs[0] = ret;
 }
 
+/** get return code from a register frame */
+static inline unsigned long arch_reg_frame_get_return(struct arch_reg_frame *regs)
+{
+	assert(regs != NULL);
+
+	return regs->regs[0];
+}
+
 /** set 64-bit return code in a register frame */
 static inline void arch_reg_frame_set_return64(struct arch_reg_frame *regs, uint64_t ret64)
 {
@@ -353,6 +362,9 @@ static inline unsigned int arch_cpu_id(void)
 #endif
 }
 
+/* cache.c */
+void arch_cache_range(unsigned int op, unsigned long start, unsigned long size);
+
 /* exception.c */
 #ifndef NDEBUG
 void arch_dump_registers(
@@ -361,12 +373,23 @@ void arch_dump_registers(
 	unsigned long fault,
 	unsigned long fsr);
 #endif
+void arch_init_cycle_counter(void);
 void arch_init_exceptions(void);
 void arch_switch_to_kernel_stack(void (*next)(void *)) __noreturn;
+#ifdef PROFILE
+void arch_profile_start(unsigned long period);
+void arch_profile_irq_handler(unsigned int irq);
+#endif
 
 static inline void arch_yield(void)
 {
 	arm_yield();
 }
 
+/** return free running cycle counter for tracing */
+static inline uint32_t arch_trace_timestamp(void)
+{
+	return arm_perf_get_ccnt();
+}
+
 #endif
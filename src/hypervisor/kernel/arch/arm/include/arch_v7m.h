@@ -274,6 +274,15 @@ static inline void arch_reg_frame_set_return(struct arch_reg_frame *regs, unsign
 	regs->psp->r0 = ret;
 }
 
+/** get return code from a register frame */
+static inline unsigned long arch_reg_frame_get_return(struct arch_reg_frame *regs)
+{
+	assert(regs != NULL);
+	assert(regs->psp != NULL);
+
+	return regs->psp->r0;
+}
+
 /** set 64-bit return code in a register frame */
 static inline void arch_reg_frame_set_return64(struct arch_reg_frame *regs, uint64_t ret64)
 {
@@ -380,6 +389,7 @@ void arch_dump_registers(
 	unsigned long fault,
 	unsigned long fsr);
 #endif
+void arch_init_cycle_counter(void);
 void arch_init_exceptions(void);
 void arch_switch_to_kernel_stack(void (*next)(void *)) __noreturn;
 
@@ -388,4 +398,15 @@ static inline void arch_yield(void)
 	arm_yield();
 }
 
+/** return free running cycle counter for tracing (DWT) */
+static inline uint32_t arch_trace_timestamp(void)
+{
+	return DWT_CYCCNT;
+}
+
+/** data cache maintenance of a memory range (no data cache on Cortex-M3/M4) */
+static inline void arch_cache_range(unsigned int op __unused, unsigned long start __unused, unsigned long size __unused)
+{
+}
+
 #endif
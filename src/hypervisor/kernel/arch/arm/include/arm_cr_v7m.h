@@ -138,6 +138,15 @@
 
 #define AFSR	_REG32(0xe000ed3c)
 
+/* DWT cycle counter */
+#define DEMCR	_REG32(0xe000edfc)
+#define DEMCR_TRCENA		0x01000000
+
+#define DWT_CTRL	_REG32(0xe0001000)
+#define DWT_CTRL_CYCCNTENA	0x00000001
+
+#define DWT_CYCCNT	_REG32(0xe0001004)
+
 /* MPU */
 #define MPU_CTRL	_REG32(0xe000ed94)
 #define MPU_CTRL_PRIVDEFENA	0x00000004
@@ -188,6 +188,14 @@ static inline void arm_inval_bp(void)
 }
 
 
+/** Get CTR (cache type register) */
+static inline unsigned long arm_get_ctr(void)
+{
+	unsigned long val;
+	__asm__ volatile ("mrc p15, 0, %0, c0, c0, 1" : "=r"(val));
+	return val;
+}
+
 /** Get MPIDR (multiprocessor ID register, for MPCore) */
 static inline unsigned long arm_get_mpidr(void)
 {
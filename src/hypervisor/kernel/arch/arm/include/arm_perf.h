@@ -27,6 +27,10 @@
 /* user enable bit */
 #define ARM_PERF_USEREN		0x00000001
 
+/* common architectural event numbers (PMXEVTYPER) */
+#define ARM_PERF_EVENT_INSTR_RETIRED	0x08	/* instruction architecturally executed */
+#define ARM_PERF_EVENT_CPU_CYCLES		0x11	/* cycle */
+
 
 #ifndef __ASSEMBLER__
 
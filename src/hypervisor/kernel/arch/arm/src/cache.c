@@ -0,0 +1,77 @@
+/*
+ * cache.c
+ *
+ * Architecture specific cache maintenance (ARMv7-A/R)
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#include <kernel.h>
+#include <assert.h>
+#include <arch.h>
+#include <hv_types.h>
+
+/** DCCMVAC: clean data cache line by address to the point of coherency */
+static inline void arm_dc_clean_line(unsigned long addr)
+{
+	__asm__ volatile ("mcr p15, 0, %0, c7, c10, 1" : : "r"(addr) : "memory");
+}
+
+/** DCIMVAC: invalidate data cache line by address to the point of coherency */
+static inline void arm_dc_inval_line(unsigned long addr)
+{
+	__asm__ volatile ("mcr p15, 0, %0, c7, c6, 1" : : "r"(addr) : "memory");
+}
+
+/** DCCIMVAC: clean and invalidate data cache line by address */
+static inline void arm_dc_flush_line(unsigned long addr)
+{
+	__asm__ volatile ("mcr p15, 0, %0, c7, c14, 1" : : "r"(addr) : "memory");
+}
+
+/** data cache maintenance of a memory range
+ *
+ * The operations work on the L1 data cache of the current core up to the
+ * point of coherency. On MPCore, the BSP enables the broadcast of the
+ * operations to the other cores (ACTLR.FW). An invalidation cleans partial
+ * cache lines at the edges of the range first, so data next to the range
+ * is not lost.
+ */
+void arch_cache_range(unsigned int op, unsigned long start, unsigned long size)
+{
+	unsigned long line_size;
+	unsigned long addr;
+	unsigned long end;
+
+	assert((op == CACHE_OP_CLEAN) || (op == CACHE_OP_INVAL) || (op == CACHE_OP_FLUSH));
+
+	/* CTR.DminLine: log2 of the number of words of the smallest line */
+	line_size = 4 << ((arm_get_ctr() >> 16) & 0xf);
+	end = start + size;
+	addr = start & ~(line_size - 1);
+
+	if (op == CACHE_OP_INVAL) {
+		if (addr != start) {
+			arm_dc_flush_line(addr);
+			addr += line_size;
+		}
+		if ((end & (line_size - 1)) != 0) {
+			end &= ~(line_size - 1);
+			if (end >= addr) {
+				arm_dc_flush_line(end);
+			}
+		}
+	}
+
+	for (; addr < end; addr += line_size) {
+		if (op == CACHE_OP_CLEAN) {
+			arm_dc_clean_line(addr);
+		} else if (op == CACHE_OP_INVAL) {
+			arm_dc_inval_line(addr);
+		} else {
+			arm_dc_flush_line(addr);
+		}
+	}
+
+	arm_dsb();
+}
@@ -15,6 +15,8 @@
 #include <arm_perf.h>
 #include <sched.h>
 #include <hm.h>
+#include <trace.h>
+#include <profile.h>
 
 
 #ifndef NDEBUG
@@ -212,7 +214,9 @@ void arm_pabt_handler_kern(struct arch_reg_frame *regs, unsigned long addr, unsi
 
 void arm_irq_handler(struct arch_reg_frame *regs __unused)
 {
+	trace_event(TRACE_EV_IRQ_ENTRY, 0, 0, 0);
 	board_irq_dispatch(0);
+	trace_event(TRACE_EV_IRQ_EXIT, 0, 0, 0);
 }
 
 void __cold arm_fiq_handler(struct arch_reg_frame *regs __unused)
@@ -220,7 +224,8 @@ void __cold arm_fiq_handler(struct arch_reg_frame *regs __unused)
 	board_nmi_dispatch(0);
 }
 
-static __init void arm_enable_performance_monitor(void)
+/** enable the cycle counter (called at kernel entry, before anything else) */
+__init void arch_init_cycle_counter(void)
 {
 	unsigned long ctrl;
 
@@ -249,9 +254,57 @@ static __init void arm_enable_performance_monitor(void)
 
 __init void arch_init_exceptions(void)
 {
-	arm_enable_performance_monitor();
+	/* NOTE: the performance monitor is enabled in arch_init_cycle_counter() */
 }
 
+#ifdef PROFILE
+/* the profiler uses the first event counter, the cycle counter is kept free */
+#define PROFILE_COUNTER			0
+#define PROFILE_COUNTER_MASK	(1u << PROFILE_COUNTER)
+
+/** number of events between two samples */
+static unsigned long profile_period;
+
+/** start the event counter used for sampling on the current CPU */
+__init void arch_profile_start(unsigned long period)
+{
+	assert(period > 0);
+	profile_period = period;
+
+	arm_perf_disable_counter(PROFILE_COUNTER_MASK);
+	arm_perf_select(PROFILE_COUNTER);
+	arm_perf_set_type(ARM_PERF_EVENT_CPU_CYCLES);
+	arm_perf_set_count(-period);
+
+	arm_perf_int_ack(PROFILE_COUNTER_MASK);
+	arm_perf_int_unmask(PROFILE_COUNTER_MASK);
+	arm_perf_enable_counter(PROFILE_COUNTER_MASK);
+}
+
+/** performance counter overflow interrupt: take a sample of the current task
+ *
+ * NOTE: the interrupted context was saved in the current register frame.
+ */
+void arch_profile_irq_handler(unsigned int irq __unused)
+{
+	struct arch_reg_frame *regs;
+
+	if (!(arm_perf_int_pending() & PROFILE_COUNTER_MASK)) {
+		/* spurious, or a different counter overflowed */
+		return;
+	}
+
+	/* rearm counter */
+	arm_perf_select(PROFILE_COUNTER);
+	arm_perf_set_count(-profile_period);
+	arm_perf_int_ack(PROFILE_COUNTER_MASK);
+
+	regs = current_sched_state()->regs;
+	assert(regs != NULL);
+	profile_sample(regs->regs[15]);
+}
+#endif
+
 /** switch over to the kernel stack and invoke next() */
 __init void arch_switch_to_kernel_stack(void (*next)(void *))
 {
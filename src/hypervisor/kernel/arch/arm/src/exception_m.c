@@ -15,6 +15,7 @@
 #include <arm_perf.h>
 #include <sched.h>
 #include <hm.h>
+#include <trace.h>
 
 
 #ifndef NDEBUG
@@ -346,7 +347,9 @@ void arm_hard_handler_kern(struct arch_reg_frame *regs)
 
 void arm_irq_handler(unsigned int vector)
 {
+	trace_event(TRACE_EV_IRQ_ENTRY, 0, vector, 0);
 	board_irq_dispatch(vector);
+	trace_event(TRACE_EV_IRQ_EXIT, 0, vector, 0);
 }
 
 void arm_nmi_handler(struct arch_reg_frame *regs __unused)
@@ -364,3 +367,12 @@ __init void arch_init_exceptions(void)
 	/* enable all exceptions */
 	SHCSR |= SHCSR_USGFAULTENA | SHCSR_BUSFAULTENA | SHCSR_MEMFAULTENA;
 }
+
+/** enable the cycle counter (called at kernel entry, before anything else) */
+__init void arch_init_cycle_counter(void)
+{
+	/* enable the DWT cycle counter for the boot log and trace timestamps */
+	DEMCR |= DEMCR_TRCENA;
+	DWT_CYCCNT = 0;
+	DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
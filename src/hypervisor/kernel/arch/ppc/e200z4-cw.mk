@@ -13,7 +13,7 @@ ARCH_AFLAGS := -mcpu=8548 -DPPC_E200Z4
 # for relocatable linking
 ARCH_LDFLAGS := -melf32ppc
 
-ARCH_MODS := entry exception string mpu
+ARCH_MODS := entry exception string mpu cache
 ARCH_MODS_SMP :=
 
 
@@ -23,7 +23,7 @@ else
 ARCH_MODS := entry
 endif
 
-ARCH_MODS += exception mpu
+ARCH_MODS += exception mpu cache
 ARCH_MODS_SMP :=
 
 
@@ -13,7 +13,7 @@ ARCH_AFLAGS := -mcpu=8548 -DPPC_E200Z6
 # for relocatable linking
 ARCH_LDFLAGS := -melf32ppc
 
-ARCH_MODS := entry exception mpu
+ARCH_MODS := entry exception mpu cache
 ARCH_MODS_SMP :=
 
 
@@ -268,6 +268,14 @@ static inline void arch_reg_frame_set_return(struct arch_reg_frame *regs, unsign
 	regs->regs[3] = ret;
 }
 
+/** get return code from a register frame */
+static inline unsigned long arch_reg_frame_get_return(struct arch_reg_frame *regs)
+{
+	assert(regs != NULL);
+
+	return regs->regs[3];
+}
+
 /** set 64-bit return code in a register frame */
 static inline void arch_reg_frame_set_return64(struct arch_reg_frame *regs, uint64_t ret64)
 {
@@ -359,6 +367,9 @@ static inline unsigned int arch_cpu_id(void)
 #endif
 }
 
+/* cache.c */
+void arch_cache_range(unsigned int op, unsigned long start, unsigned long size);
+
 /* exception.c */
 #ifndef NDEBUG
 void arch_dump_registers(
@@ -367,6 +378,7 @@ void arch_dump_registers(
 	unsigned long fault,
 	unsigned long esr);
 #endif
+void arch_init_cycle_counter(void);
 void arch_init_exceptions(void);
 void arch_switch_to_kernel_stack(void (*next)(void *)) __noreturn;
 
@@ -375,4 +387,10 @@ static inline void arch_yield(void)
 	barrier();
 }
 
+/** return free running time base for tracing */
+static inline uint32_t arch_trace_timestamp(void)
+{
+	return ppc_get_spr(SPR_TBL);
+}
+
 #endif
@@ -143,4 +143,22 @@ static inline void ppc_tlbwe(void)
 	__asm__ volatile ("tlbwe" : : : "memory");
 }
 
+/** DCBST: clean data cache line */
+static inline void ppc_dcbst(unsigned long addr)
+{
+	__asm__ volatile ("dcbst 0, %0" : : "r"(addr) : "memory");
+}
+
+/** DCBI: invalidate data cache line (supervisor only) */
+static inline void ppc_dcbi(unsigned long addr)
+{
+	__asm__ volatile ("dcbi 0, %0" : : "r"(addr) : "memory");
+}
+
+/** DCBF: clean and invalidate data cache line */
+static inline void ppc_dcbf(unsigned long addr)
+{
+	__asm__ volatile ("dcbf 0, %0" : : "r"(addr) : "memory");
+}
+
 #endif
@@ -0,0 +1,58 @@
+/*
+ * cache.c
+ *
+ * Architecture specific cache maintenance (e200)
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#include <kernel.h>
+#include <assert.h>
+#include <arch.h>
+#include <hv_types.h>
+
+/** cache line size of the e200z4 and e200z6 cores */
+#define PPC_CACHE_LINE_SIZE	32
+
+/** data cache maintenance of a memory range
+ *
+ * The operations work on the L1 data cache of the current core.
+ * The e200 cores have no snooping, so the other cores are not affected.
+ * An invalidation cleans partial cache lines at the edges of the range first,
+ * so data next to the range is not lost.
+ */
+void arch_cache_range(unsigned int op, unsigned long start, unsigned long size)
+{
+	unsigned long addr;
+	unsigned long end;
+
+	assert((op == CACHE_OP_CLEAN) || (op == CACHE_OP_INVAL) || (op == CACHE_OP_FLUSH));
+
+	end = start + size;
+	addr = start & ~(PPC_CACHE_LINE_SIZE - 1);
+
+	if (op == CACHE_OP_INVAL) {
+		if (addr != start) {
+			ppc_dcbf(addr);
+			addr += PPC_CACHE_LINE_SIZE;
+		}
+		if ((end & (PPC_CACHE_LINE_SIZE - 1)) != 0) {
+			end &= ~(PPC_CACHE_LINE_SIZE - 1);
+			if (end >= addr) {
+				ppc_dcbf(end);
+			}
+		}
+	}
+
+	for (; addr < end; addr += PPC_CACHE_LINE_SIZE) {
+		if (op == CACHE_OP_CLEAN) {
+			ppc_dcbst(addr);
+		} else if (op == CACHE_OP_INVAL) {
+			ppc_dcbi(addr);
+		} else {
+			ppc_dcbf(addr);
+		}
+	}
+
+	ppc_sync();
+}
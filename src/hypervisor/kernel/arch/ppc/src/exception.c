@@ -37,6 +37,7 @@
 #include <ppc_tlb.h>
 #include <sched.h>
 #include <hm.h>
+#include <trace.h>
 
 /*==================[macros]==================================================*/
 
@@ -137,7 +138,9 @@ void ppc_handler_panic(struct arch_reg_frame *regs, unsigned int vector)
 /* IRQ */
 void ppc_handler_irq(struct arch_reg_frame *regs __unused, unsigned int vector)
 {
+	trace_event(TRACE_EV_IRQ_ENTRY, 0, vector, 0);
 	board_irq_dispatch(vector);
+	trace_event(TRACE_EV_IRQ_EXIT, 0, vector, 0);
 }
 
 /* critical IRQ */
@@ -351,6 +354,12 @@ void ppc_handler_spe(struct arch_reg_frame *regs, unsigned int vector)
 }
 
 
+/** enable the cycle counter (called at kernel entry, before anything else) */
+__init void arch_init_cycle_counter(void)
+{
+	/* NOTE: the time base is already enabled by the BSP startup code */
+}
+
 __init void arch_init_exceptions(void)
 {
 	ppc_set_ivors();
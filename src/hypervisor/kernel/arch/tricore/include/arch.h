@@ -278,6 +278,16 @@ static inline void arch_reg_frame_set_return(struct arch_reg_frame *regs, unsign
 	regs->csa[0].cx.l.d2 = ret;
 }
 
+/** get return code from a register frame */
+static inline unsigned long arch_reg_frame_get_return(struct arch_reg_frame *regs)
+{
+	assert(regs != NULL);
+	assert(regs->csa != NULL);
+
+	/* csa[0] is LOWER */
+	return regs->csa[0].cx.l.d2;
+}
+
 /** set 64-bit return code in a register frame */
 static inline void arch_reg_frame_set_return64(struct arch_reg_frame *regs, uint64_t ret64)
 {
@@ -381,6 +391,7 @@ void arch_dump_registers(
 	unsigned long fault,
 	unsigned long higher_cx);
 #endif
+void arch_init_cycle_counter(void);
 void arch_init_exceptions(void);
 void arch_switch_to_kernel_stack(void (*next)(void *)) __noreturn;
 
@@ -389,4 +400,15 @@ static inline void arch_yield(void)
 	barrier();
 }
 
+/** return free running cycle counter for tracing */
+static inline uint32_t arch_trace_timestamp(void)
+{
+	return MFCR(CSFR_CCNT);
+}
+
+/** data cache maintenance of a memory range (not supported, use non-cached segments instead) */
+static inline void arch_cache_range(unsigned int op __unused, unsigned long start __unused, unsigned long size __unused)
+{
+}
+
 #endif
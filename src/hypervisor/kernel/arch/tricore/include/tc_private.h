@@ -17,6 +17,9 @@ __tc_fastcall void tc_handler_nmi(void *lower, unsigned long higher_cx);
 __tc_fastcall void tc_handler_trap_kern(void *lower, unsigned long higher_cx, unsigned long class, unsigned long tin);
 __tc_fastcall void tc_handler_trap_user(void *lower, unsigned long higher_cx, unsigned long class, unsigned long tin);
 __tc_fastcall void tc_handler_fcu(unsigned long higher_cx, unsigned long pc);
+#ifdef TRACE
+void tc_handler_irq(unsigned int irq);
+#endif
 
 /* entry.S */
 void tc_trap_table_start(void);
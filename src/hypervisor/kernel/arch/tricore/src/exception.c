@@ -14,6 +14,8 @@
 #include <tc_private.h>
 #include <sched.h>
 #include <hm.h>
+#include <isr.h>
+#include <trace.h>
 
 
 #ifndef NDEBUG
@@ -257,6 +259,23 @@ __tc_fastcall __cold void tc_handler_fcu(unsigned long higher_cx, unsigned long
 	hm_exception(NULL, 1, HM_ERROR_CONTEXT_ERROR, (TRAP_CTXT<<16)|TIN_FCU, pc, higher_cx);
 }
 
+#ifdef TRACE
+/* IRQ, entry.S dispatches here instead of isr_cfg[] to trace the IRQ */
+void tc_handler_irq(unsigned int irq)
+{
+	trace_event(TRACE_EV_IRQ_ENTRY, 0, irq, 0);
+	isr_cfg[irq].func(isr_cfg[irq].arg0);
+	trace_event(TRACE_EV_IRQ_EXIT, 0, irq, 0);
+}
+#endif
+
+/** enable the cycle counter (called at kernel entry, before anything else) */
+__init void arch_init_cycle_counter(void)
+{
+	/* enable CPU cycle counter (multi counters 1..3 not set) */
+	MTCR_ISYNC(CSFR_CCTRL, 0x02);
+}
+
 __init void arch_init_exceptions(void)
 {
 	unsigned int syscon;
@@ -297,9 +316,6 @@ __init void arch_init_exceptions(void)
 
 	/* NOTE: the MPU is enabled in board_mpu_init() in the board layer */
 
-	/* enable CPU cycle counter (multi counters 1..3 not set) */
-	MTCR_ISYNC(CSFR_CCTRL, 0x02);
-
 	/* ENDINIT protection is enabled by board_cpu0_up() or
 	 * board_startup_complete() later
 	 */
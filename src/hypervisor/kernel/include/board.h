@@ -198,12 +198,25 @@ int board_hm_exception(
  *
  * \see board_nmi_dispatch()
  * \see kernel_wake_isr_task()
+ * \see kernel_isr_flh()
  * \see kernel_increment_counter()
  * \see kernel_timer()
  * \see kernel_ipi_handle()
  */
 void board_irq_dispatch(unsigned int vector);
 
+/** Force a kernel re-entry on the current processor core
+ *
+ * A call to this function raises a software interrupt on the current
+ * processor core. The interrupt is taken right after the kernel returned
+ * to user space, so the kernel is entered again and runs the scheduler.
+ * The kernel uses this to continue work it split into bounded steps.
+ * The board layer only acknowledges the interrupt, nothing else is done.
+ *
+ * \see board_irq_dispatch()
+ */
+void board_kernel_reentry(void);
+
 /** Dispatch NMI
  *
  * A call to this function requests dispatching of a non-maskable interrupt
@@ -0,0 +1,48 @@
+/*
+ * bootlog.h
+ *
+ * Boot-time profiling of the kernel and partition initialization.
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#ifndef __BOOTLOG_H__
+#define __BOOTLOG_H__
+
+#include <stdint.h>
+#include <hv_compiler.h>
+#include <hv_types.h>
+
+/*
+ * The boot phases (BOOTLOG_* in hv_types.h) are stamped with the free
+ * running cycle counter of arch_trace_timestamp(), which is enabled by
+ * arch_init_cycle_counter() at kernel entry, long before the system timer
+ * is running. The first processor records the kernel phases, each
+ * partition records its start and its first transition to NORMAL mode.
+ *
+ * The log is printed in verbose builds before board_startup_complete()
+ * and can be read by privileged partitions with sys_bootlog().
+ */
+
+/* forward declaration */
+struct part;
+
+/** record the kernel entry on the current CPU (called first in kernel_main) */
+void bootlog_init(void);
+
+/** record the entry of a boot phase (only recorded on the first CPU) */
+void bootlog_phase(unsigned int phase);
+
+/** record the start of a partition */
+void bootlog_part_start(struct part *part);
+
+/** record the first transition of a partition to NORMAL mode */
+void bootlog_part_normal(struct part *part);
+
+/** print the boot phases recorded so far */
+void bootlog_print(void);
+
+/** system call to retrieve the boot log and the boot times of a partition */
+__tc_fastcall void sys_bootlog(unsigned int part_id, bootlog_t *log);
+
+#endif
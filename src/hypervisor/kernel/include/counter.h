@@ -22,6 +22,9 @@ extern const struct counter_access counter_access[];
 /** Initializer */
 void counter_init_all_per_cpu(void);
 
+/** publish tick count and counter values to the current partition's user space */
+void counter_publish_time(void);
+
 
 /* counter handling */
 
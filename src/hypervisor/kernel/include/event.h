@@ -26,8 +26,17 @@ __tc_fastcall void sys_ev_wait_get_clear(evmask_t mask, evmask_t clear);
 /** Set an event in a task's pending event mask in own or remote partition */
 __tc_fastcall void sys_ipev_set(unsigned int ipev_id);
 
+/** Set events in all tasks of an inter-partition event group */
+__tc_fastcall void sys_ipev_group_set(unsigned int group_id);
+
 
 /* internal event set routine */
 unsigned int ev_set(struct task *task, evmask_t mask);
 
+/* forward declaration */
+struct ipev_group_cpu_cfg;
+
+/* set events in the IPEV group targets of the current CPU */
+void ipev_group_signal(const struct ipev_group_cpu_cfg *group_cpu);
+
 #endif
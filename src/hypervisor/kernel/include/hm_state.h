@@ -106,9 +106,9 @@
 #define HM_ERROR_STACK_OVERFLOW			27	/* stack overflow */
 
 #define HM_ERROR_DEADLINE_MISSED		28	/* task deadline missed */
-#define HM_ERROR_TASK_ACTIVATION_ERROR	29	/* task activation error (multiple activation) */
+#define HM_ERROR_TASK_ACTIVATION_ERROR	29	/* task activation error (multiple activation or inter-arrival time violation) */
 #define HM_ERROR_TASK_STATE_ERROR		30	/* task state error (wrong state in event set) */
-/*      not yet assigned                31 */
+#define HM_ERROR_BUDGET_EXCEEDED		31	/* task execution budget exceeded */
 
 /* NOTE: errors from here on can be raised by the partition via sys_hm_inject() */
 #define HM_ERROR_ABORT					32	/* user called sys_abort() */
@@ -206,7 +206,7 @@
 #define HM_ACTION_DEFAULT_PARTITION_28	(HM_ACTION_TASK_IDLE | E_OS_PROTECTION_TIME)
 #define HM_ACTION_DEFAULT_PARTITION_29	(HM_ACTION_TASK_IDLE | E_OS_LIMIT)
 #define HM_ACTION_DEFAULT_PARTITION_30	(HM_ACTION_TASK_IDLE | E_OS_STATE)
-#define HM_ACTION_DEFAULT_PARTITION_31	HM_ACTION_TASK_IDLE /* not assigned yet */
+#define HM_ACTION_DEFAULT_PARTITION_31	(HM_ACTION_TASK_IDLE | E_OS_PROTECTION_TIME)
 
 #define HM_ACTION_DEFAULT_PARTITION_32	HM_ACTION_PARTITION_IDLE
 #define HM_ACTION_DEFAULT_PARTITION_33	HM_ACTION_PARTITION_IDLE
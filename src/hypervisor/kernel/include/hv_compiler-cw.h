@@ -87,6 +87,7 @@
 #define __section_context_core(x)	__section(.core ## x.bss.context)
 #define __section_reg_core(x)		__section(.core ## x.bss.reg)
 #define __section_bss_core(x)		__section(.core ## x.bss)
+#define __section_shared_core(x)	__section(.core ## x.bss.shared)	/* accessed by other cores */
 #define __section_data_core(x)		__section(.core ## x.data)
 #define __section_sched_state_core(x)	__section(.core ## x.bss.sched_state)
 #define __section_cfg				__section(.rodata.cfg)
@@ -201,6 +201,8 @@ __syscall unsigned int sys_task_terminate_other(unsigned int task_id);
  * \retval E_OS_ID			Invalid task ID
  * \retval E_OS_ACCESS		Task refers to an ISR or hook
  * \retval E_OS_ACCESS		Task is a non-activatable task
+ * \retval E_OS_LIMIT		Configured limit of pending activations reached
+ * \retval E_OS_PROTECTION_ARRIVAL	Configured inter-arrival time not elapsed
  *
  * \note On success, this function does not returns to the caller.
  *
@@ -228,6 +230,7 @@ __syscall unsigned int sys_task_chain(unsigned int task_id);
  * \retval E_OS_ACCESS		Task refers to an ISR or hook
  * \retval E_OS_ACCESS		Task is a non-activatable task
  * \retval E_OS_LIMIT		Configured limit of pending activations reached
+ * \retval E_OS_PROTECTION_ARRIVAL	Configured inter-arrival time not elapsed
  *
  * \see sys_task_create()
  * \see sys_task_delayed_activate()
@@ -498,6 +501,25 @@ static inline __alwaysinline unsigned int sys_ev_wait(evmask_t mask)
  */
 __syscall unsigned int sys_ipev_set(unsigned int ipev_id);
 
+/** Set events in all tasks of an inter-partition event group
+ *
+ * A successful call to this function sets the configured events
+ * in the pending event masks of all target tasks of the inter partition
+ * event group \a group_id, as if sys_ipev_set() was called for each target.
+ * Targets on other processors are notified with a single IPI per processor.
+ *
+ * \param [in] group_id		ID of the inter partition event group
+ *
+ * \retval E_OK				Success
+ * \retval E_OS_ID			Invalid IPEV group ID
+ *
+ * \see sys_ipev_set()
+ *
+ * \note No error is returned if a target task is in suspended state
+ * or its partition is not active. The event is lost for this target.
+ */
+__syscall unsigned int sys_ipev_group_set(unsigned int group_id);
+
 
 /** Call a kernel level device driver (KLDD)
  *
@@ -623,6 +645,10 @@ __syscall unsigned int sys_part_get_operating_mode_ex(
  * - The transition to WARM_START requires that the partition is in NORMAL mode
  *   or is in IDLE mode, but was in NORMAL mode before entering IDLE mode
  * - The transition to NORMAL mode is prohibited.
+ * - A partition waiting for its deferred start (PART_FLAG_DEFERRED_START)
+ *   is started early by COLD_START, even if it is not restartable.
+ * - A request while a previous state change of the partition is still
+ *   in progress, e.g. a shutdown, replaces the target mode of that change.
  *
  * \param [in] part_id		Partition ID
  * \param [in] new_mode		Operating mode
@@ -703,6 +729,46 @@ __syscall unsigned int sys_ctr_get(unsigned int ctr_id, ctrtick_t *value);
  */
 __syscall unsigned int sys_ctr_elapsed(unsigned int ctr_id, ctrtick_t previous, ctrtick_t *value, ctrtick_t *elapsed);
 
+/** Get current counter value without system call overhead
+ *
+ * This service reads the value of the counter \a ctr_id from the time state
+ * the kernel publishes in user space. Counters that are not published
+ * (hardware counters or counters of other processors) are queried
+ * with sys_ctr_get().
+ *
+ * \param [in] ctr_id		Counter ID
+ * \param [out] value		Current counter value
+ *
+ * \retval E_OK				Success
+ * \retval E_OS_ID			Invalid counter ID
+ *
+ * \see sys_ctr_get()
+ * \see sys_fast_ctr_elapsed()
+ * \see user_time_state_t
+ */
+unsigned int sys_fast_ctr_get(unsigned int ctr_id, ctrtick_t *value);
+
+/** Get elapsed counter value in ticks without system call overhead
+ *
+ * This service is the equivalent of sys_ctr_elapsed() based on the time state
+ * the kernel publishes in user space. Counters that are not published
+ * and invalid values of \a previous are handled by sys_ctr_elapsed().
+ *
+ * \param [in] ctr_id		Counter ID
+ * \param [in] previous		Previous counter value
+ * \param [out] value		Current counter value
+ * \param [out] elapsed		Elapsed time to \a previous
+ *
+ * \retval E_OK				Success
+ * \retval E_OS_ID			Invalid counter ID
+ * \retval E_OS_VALUE		Value of \a previous exceeds the counter range
+ *
+ * \see sys_ctr_elapsed()
+ * \see sys_fast_ctr_get()
+ * \see user_time_state_t
+ */
+unsigned int sys_fast_ctr_elapsed(unsigned int ctr_id, ctrtick_t previous, ctrtick_t *value, ctrtick_t *elapsed);
+
 /** Get configuration of counter associated to alarm
  *
  * A successful call to this function returns the configuration attributes
@@ -1165,6 +1231,78 @@ __syscall unsigned int sys_replenish(timeout_t budget);
  */
 __syscall unsigned int sys_wait_periodic(void);
 
+/** Get execution time statistics of a task
+ *
+ * A call to this function retrieves the accumulated execution time and
+ * the execution time and response time watermarks of task \a task_id
+ * in the caller's partition, and the accumulated execution time
+ * of the partition.
+ *
+ * \param [in] task_id		ID of the task
+ * \param [out] stats		Execution time statistics (8 byte aligned)
+ *
+ * \retval E_OK				Success
+ * \retval E_OS_ID			Invalid task ID
+ * \retval E_OS_ILLEGAL_ADDRESS	\a stats is not accessible or misaligned
+ *
+ * \see sys_part_exec_stats()
+ * \see exec_stats_t
+ */
+__syscall unsigned int sys_task_exec_stats(
+	unsigned int task_id,
+	exec_stats_t *stats);
+
+/** Get execution time statistics of a task in another partition
+ *
+ * A call to this function retrieves the execution time statistics of
+ * task \a task_id in partition \a part_id.
+ * Only privileged partitions are allowed to call this function.
+ *
+ * \note The statistics of tasks on other processors are accounted
+ * up to their last context switch.
+ *
+ * \param [in] part_id		ID of the partition
+ * \param [in] task_id		ID of the task in the partition
+ * \param [out] stats		Execution time statistics (8 byte aligned)
+ *
+ * \retval E_OK				Success
+ * \retval E_OS_ACCESS		Caller's partition is not privileged
+ * \retval E_OS_ID			Invalid partition or task ID
+ * \retval E_OS_ILLEGAL_ADDRESS	\a stats is not accessible or misaligned
+ *
+ * \see sys_task_exec_stats()
+ * \see exec_stats_t
+ */
+__syscall unsigned int sys_part_exec_stats(
+	unsigned int part_id,
+	unsigned int task_id,
+	exec_stats_t *stats);
+
+/** Get the boot log
+ *
+ * A call to this function retrieves the timestamps of the kernel boot
+ * phases and the start and first NORMAL mode transition of partition
+ * \a part_id, e.g. to check the cold start budget of the system.
+ * Only privileged partitions are allowed to call this function.
+ *
+ * \note The timestamps are raw cycle counter values relative to the kernel
+ * entry. The partition timestamps are zero until the partition reaches
+ * the respective state for the first time.
+ *
+ * \param [in] part_id		ID of the partition
+ * \param [out] log			Boot log (4 byte aligned)
+ *
+ * \retval E_OK				Success
+ * \retval E_OS_ACCESS		Caller's partition is not privileged
+ * \retval E_OS_ID			Invalid partition ID
+ * \retval E_OS_ILLEGAL_ADDRESS	\a log is not accessible or misaligned
+ *
+ * \see bootlog_t
+ */
+__syscall unsigned int sys_bootlog(
+	unsigned int part_id,
+	bootlog_t *log);
+
 
 /** Retrieve shared memory attributes
  *
@@ -1384,4 +1522,36 @@ __syscall unsigned int sys_rpc_reply(
 	unsigned long reply_arg,
 	int terminate);
 
+/** Execute a batch of system calls
+ *
+ * A call to this function executes the \a num system calls described
+ * in the array \a calls in order with a single kernel entry.
+ * Each entry specifies the system call ID and up to three arguments.
+ * The kernel stores the result of each system call in the entry's \a ret
+ * field. A failing entry does not stop the batch.
+ *
+ * The following system calls can be batched:
+ * - SYSCALL_TASK_ACTIVATE
+ * - SYSCALL_EV_SET and SYSCALL_EV_CLEAR
+ * - SYSCALL_IPEV_SET and SYSCALL_IPEV_GROUP_SET
+ * - SYSCALL_CTR_INCREMENT
+ * - SYSCALL_ALARM_SET_REL, SYSCALL_ALARM_SET_ABS and SYSCALL_ALARM_CANCEL
+ * - SYSCALL_WQ_WAKE
+ * - SYSCALL_ISR_MASK and SYSCALL_ISR_UNMASK
+ *
+ * Other system call IDs fail with E_OS_NOFUNC in their entry.
+ *
+ * \param [in,out] calls	Array of multicall entries
+ * \param [in] num			Number of entries (1 to MULTICALL_MAX)
+ *
+ * \retval E_OK				Success, results are stored in the entries
+ * \retval E_OS_VALUE		Invalid number of entries
+ * \retval E_OS_ILLEGAL_ADDRESS	Invalid or unaligned address of \a calls
+ *
+ * \see multicall_t
+ *
+ * \note Scheduling decisions are deferred until the batch completes.
+ */
+__syscall unsigned int sys_multicall(multicall_t *calls, unsigned int num);
+
 #endif
@@ -38,6 +38,63 @@ typedef int64_t timeout_t;
  */
 typedef uint32_t evmask_t;
 
+/** Counter value
+ *
+ * The kernel uses an unsigned 32 bit data type for counter values.
+ */
+typedef uint32_t ctrtick_t;
+
+/** Counter phase
+ *
+ * The kernel uses a signed 32 bit data type for counter phases.
+ * In relation to another counter, a phase value expresses:
+ * - a negative value expresses a phase ahead of a related counter
+ * - a positive value expresses a phase behind a related counter
+ * - a zero value expresses that phases are synchronous
+ */
+typedef int32_t ctrphase_t;
+
+/** Number of counters published in the user time state */
+#define USER_TIME_NUM_CTRS	8
+
+/** User time state
+ *
+ * The kernel publishes the tick count and the values of the counters
+ * the current partition can access to user space, so reading counters
+ * does not require a system call. The system time is not published,
+ * as user space cannot extrapolate it between two ticks on all boards.
+ * Use sys_gettime() instead.
+ * The data is updated on each timer tick, whenever a counter changes,
+ * and when the partition is scheduled.
+ *
+ * The kernel increments \a seq before and after updating the data,
+ * i.e. \a seq is odd while an update is in progress. Readers retry
+ * if \a seq is odd or changed while reading.
+ *
+ * Bit n in \a ctr_valid indicates that \a ctr[n] reflects the current value
+ * of the partition's counter ID n. Hardware counters (except the system timer)
+ * and counters of other processors are not published, as their values
+ * can only be queried in the kernel.
+ *
+ * \see sys_fast_ctr_get()
+ * \see sys_fast_ctr_elapsed()
+ */
+typedef struct {
+	/** Sequence counter, odd while the kernel updates the data */
+	volatile uint32_t seq;
+	/** Timer resolution in nanoseconds */
+	uint32_t resolution;
+	/** Number of timer ticks since boot */
+	uint32_t ticks;
+	/** Bitmask of published counter IDs */
+	uint32_t ctr_valid;
+	/** Counter values and limits, indexed by the partition's counter ID */
+	struct {
+		ctrtick_t value;
+		ctrtick_t maxallowedvalue;
+	} ctr[USER_TIME_NUM_CTRS];
+} user_time_state_t;
+
 /** User scheduling state
  *
  * The user scheduling state is part of the user <-> kernel protocol
@@ -54,7 +111,10 @@ typedef uint32_t evmask_t;
  * The kernel updates \a next_prio to reflect the priority of the next task
  * to schedule.
  *
- * Lastly, \a taskid contains the current task ID.
+ * Also, \a taskid contains the current task ID.
+ *
+ * Lastly, \a time provides a read-only view on the tick count
+ * and on counter values.
  */
 typedef struct {
 	/** Current Task ID */
@@ -63,24 +123,81 @@ typedef struct {
 	uint8_t user_prio;
 	/** Next Pending Task's Priority in the scheduler */
 	uint8_t next_prio;
+	uint8_t padding[4];
+	/** Time and counter state (written by the kernel only) */
+	user_time_state_t time;
 } user_sched_state_t;
 
+/** Execution time statistics
+ *
+ * Execution time statistics of a task and its partition
+ * as recorded by the scheduler, all values in nanoseconds.
+ * The execution time of an activation is only accounted when the activation
+ * completes, i.e. the task terminates or waits for its next release point.
+ *
+ * \see sys_task_exec_stats()
+ * \see sys_part_exec_stats()
+ */
+typedef struct {
+	/** Accumulated execution time of the task since boot */
+	time_t exec_time;
+	/** Maximum observed execution time of a single activation */
+	time_t max_exec_time;
+	/** Maximum observed response time (activation to completion) */
+	time_t max_response_time;
+	/** Accumulated execution time of the task's partition since boot */
+	time_t part_exec_time;
+	/** Part of \a part_exec_time reclaimed from idle time of other windows */
+	time_t part_slack_time;
+} exec_stats_t;
 
-/** Counter value
+/** Boot log phases
  *
- * The kernel uses an unsigned 32 bit data type for counter values.
+ * Each phase is stamped when the kernel enters it on the first processor.
  */
-typedef uint32_t ctrtick_t;
+#define BOOTLOG_KERNEL_MAIN			0	/* entry of the kernel */
+#define BOOTLOG_FURTHER_INIT		1	/* scheduler, exceptions and MPU set up, on the kernel stack */
+#define BOOTLOG_PART_INIT			2	/* board up, initialization of the partitions */
+#define BOOTLOG_OBJ_INIT			3	/* initialization of tasks, alarms, schedule tables, wait queues */
+#define BOOTLOG_STARTUP_COMPLETE	4	/* secondary processors booted, board startup complete */
+#define BOOTLOG_SYNC_START			5	/* all processors synchronized at the scheduling epoch */
+#define BOOTLOG_PART_START			6	/* start of the partitions */
+#define BOOTLOG_RUNNING				7	/* partitions started, leaving to user space */
+#define BOOTLOG_NUM_PHASES			8
 
-/** Counter phase
+/** Boot log
  *
- * The kernel uses a signed 32 bit data type for counter phases.
- * In relation to another counter, a phase value expresses:
- * - a negative value expresses a phase ahead of a related counter
- * - a positive value expresses a phase behind a related counter
- * - a zero value expresses that phases are synchronous
+ * All timestamps are raw values of the free running cycle counter
+ * (or time base on PowerPC) relative to the entry of the kernel
+ * on the respective processor. They are not converted to nanoseconds,
+ * as the counter runs before the system timer is set up.
+ * The counter is only 32 bits wide and wraps after a few seconds.
+ *
+ * \see sys_bootlog()
  */
-typedef int32_t ctrphase_t;
+typedef struct {
+	/** Entry of the boot phases on the first processor (BOOTLOG_*) */
+	uint32_t phase[BOOTLOG_NUM_PHASES];
+	/** Start of the partition, i.e. activation of the init hook (0 if not started yet) */
+	uint32_t part_start;
+	/** First transition of the partition to NORMAL mode (0 if not reached yet) */
+	uint32_t part_normal;
+} bootlog_t;
+
+/** Cache maintenance operations of the cache KLDD
+ *
+ * \see kldd_cache_range()
+ */
+#define CACHE_OP_CLEAN		1	/**< write back dirty lines (before DMA reads memory) */
+#define CACHE_OP_INVAL		2	/**< discard lines (after DMA wrote memory) */
+#define CACHE_OP_FLUSH		3	/**< write back and discard lines */
+
+/** Upper bound of the range size of one call to the cache KLDD
+ *
+ * The kernel is not preemptible while it maintains the range, so larger
+ * ranges must be split into multiple calls.
+ */
+#define CACHE_OP_MAX_SIZE	4096
 
 /** Wait queue queuing discipline */
 #define WQ_DISCIPLINE_FIFO	0
@@ -152,6 +269,26 @@ typedef struct {
 	unsigned long fault_addr;
 } user_exception_state_t;
 
+/** Maximum number of entries in a multicall batch */
+#define MULTICALL_MAX	16
+
+/** Multicall entry
+ *
+ * One entry in a batch of system calls passed to sys_multicall().
+ * The caller fills in the system call ID \a id (SYSCALL_* in syscalls.h)
+ * and the arguments \a args, the kernel stores the result in \a ret.
+ *
+ * \see sys_multicall()
+ */
+typedef struct {
+	/** System call ID */
+	unsigned int id;
+	/** Result of the system call (written by the kernel) */
+	unsigned int ret;
+	/** Arguments, unused arguments are ignored */
+	unsigned long args[3];
+} multicall_t;
+
 /** Halt mode
  *
  * Modes to halt or reset the system.
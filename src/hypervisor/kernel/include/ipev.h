@@ -14,4 +14,7 @@
 /** IPEV configuration -> config.c */
 extern const struct ipev_cfg ipev_cfg[];
 
+/** IPEV group configuration -> config.c */
+extern const struct ipev_group_cfg ipev_group_cfg[];
+
 #endif
@@ -10,6 +10,7 @@
 #define __IPEV_STATE_H__
 
 #include <stdint.h>
+#include <sched_state.h>
 
 /** upper limit of IPEVs in the system (so we can use 16-bit indices) */
 #define MAX_IPEVS	65536
@@ -21,4 +22,17 @@ struct ipev_cfg {
 	uint8_t padding;
 };
 
+/** IPEV group targets on a specific CPU */
+struct ipev_group_cpu_cfg {
+	/** targets on this CPU (array of num_targets entries) */
+	const struct ipev_cfg *targets;
+	uint16_t num_targets;
+	uint16_t padding;
+};
+
+/** IPEV group type, targets are sorted by CPU */
+struct ipev_group_cfg {
+	struct ipev_group_cpu_cfg cpu[MAX_CPUS];
+};
+
 #endif
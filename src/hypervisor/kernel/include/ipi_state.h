@@ -24,6 +24,7 @@ struct schedtab;
 struct part;
 struct wq;
 struct tpschedule_cfg;
+struct ipev_group_cpu_cfg;
 
 
 /** per-core IPI config */
@@ -53,6 +54,7 @@ struct ipi_state {
 #define IPI_ACTION_PART_STATE	5	/* partition state change */
 #define IPI_ACTION_SCHEDULE_CHANGE	6	/* change time partition schedule */
 #define IPI_ACTION_EVENT_NOERR	7	/* set event "aux" to task "task", no error */
+#define IPI_ACTION_IPEV_GROUP	8	/* set events of IPEV group targets */
 
 /** IPI action */
 struct ipi_action {
@@ -74,6 +76,8 @@ struct ipi_action {
 		struct wq *wq;
 		/** next time partition schedule table */
 		const struct tpschedule_cfg *next_tpschedule;
+		/** IPEV group targets on the target CPU */
+		const struct ipev_group_cpu_cfg *ipev_group_cpu;
 		/** generic pointer */
 		const void *object;
 	} u;
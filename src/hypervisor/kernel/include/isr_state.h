@@ -9,6 +9,12 @@
 #ifndef __ISR_STATE_H__
 #define __ISR_STATE_H__
 
+#include <stdint.h>
+
+/* forward declarations */
+struct task;
+struct task_cfg;
+
 /** upper limit of ISRs in the system (so we can use 16-bit indices) */
 #define MAX_ISRS	1024
 
@@ -18,4 +24,28 @@ struct isr_cfg {
 	const void *arg0;				/* regsitered argument */
 };
 
+/* results of a first-level handler's acknowledge function */
+#define ISR_FLH_DONE		0	/**< interrupt fully handled in the kernel */
+#define ISR_FLH_EVENT		1	/**< set the event in the target task */
+#define ISR_FLH_ACTIVATE	2	/**< activate the ISR task */
+
+/** first-level handler of a user ISR (acknowledge + event only)
+ *
+ * The ISR table entry points to kernel_isr_flh() with this configuration.
+ * Instead of activating the ISR task, the kernel acknowledges the device
+ * and sets an event in a task of the ISR's partition. The interrupt source
+ * stays unmasked, unless the ISR task's inter-arrival time is violated.
+ */
+struct isr_flh_cfg {
+	/** optional acknowledge function, returns ISR_FLH_* */
+	unsigned int (*ack)(const void *arg0);
+	const void *ack_arg0;
+	/** target task of the event */
+	struct task *task;
+	/** ISR task, activated for ISR_FLH_ACTIVATE */
+	const struct task_cfg *isr_task_cfg;
+	uint8_t event_bit;
+	uint8_t padding[3];
+};
+
 #endif
@@ -144,6 +144,22 @@ void _printf(const char *format, ...) __printflike(1, 2);
  */
 void kernel_wake_isr_task(const void *arg0);
 
+/** First-level handler of a user ISR
+ *
+ * This function is registered in the ISR table instead of
+ * kernel_wake_isr_task() for ISRs with a first-level handler.
+ * It calls the optional acknowledge function of the device and then
+ * sets an event in the target task, activates the ISR task, or does
+ * nothing, depending on the acknowledge function's result.
+ * The interrupt source is only masked when the ISR task is activated.
+ *
+ * \param [in] arg0			Argument of type struct isr_flh_cfg
+ *
+ * \see board_irq_dispatch()
+ * \see kernel_wake_isr_task()
+ */
+void kernel_isr_flh(const void *arg0);
+
 /* counter.c */
 /** Notification in hardware counter increment
  *
@@ -18,4 +18,8 @@ extern const struct kldd_cfg kldd_cfg[];
 __tc_fastcall void sys_kldd_call(unsigned int kldd_id, unsigned long arg1,
                            unsigned long arg2, unsigned long arg3);
 
+/** KLDD for data cache maintenance of a memory range of the caller */
+unsigned int kldd_cache_range(void *arg0, unsigned long addr,
+                              unsigned long size, unsigned long op);
+
 #endif
@@ -0,0 +1,72 @@
+/*
+ * lz4.h
+ *
+ * Decompressor for LZ4 compressed .data images in ROM.
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#ifndef __LZ4_H__
+#define __LZ4_H__
+
+#include <stdint.h>
+#include <hv_compiler.h>
+
+/*
+ * scripts/ab_gen_romimage.pl -z replaces the .data load image of the kernel
+ * or a partition in the ROM image with a compressed image, if the image
+ * shrinks. The compressed image starts with a 16 byte header, followed by
+ * the data in LZ4 block format:
+ *
+ *   offset  0: magic "LZ4D"
+ *   offset  4: size of the compressed data (32-bit little endian)
+ *   offset  8: size of the uncompressed data (32-bit little endian)
+ *   offset 12: reserved, zero
+ *
+ * The image replaces the uncompressed .data image at the same address.
+ * If the .data image is at the end of a ROM section, the section shrinks
+ * to the size of the compressed image (see ab_gen_memory_xml.pl -z).
+ * Images smaller than the header are never compressed.
+ *
+ * The decompressor does not use any global data, so the BSP startup code
+ * can call it with just a stack before .data and .bss are initialized.
+ * For the same reason, it does not assert on corrupt data, but returns an
+ * error to the caller.
+ */
+
+/** size of the image header */
+#define LZ4_IMAGE_HDR_SIZE	16
+
+/** magic bytes of a compressed image */
+#define LZ4_IMAGE_MAGIC0	'L'
+#define LZ4_IMAGE_MAGIC1	'Z'
+#define LZ4_IMAGE_MAGIC2	'4'
+#define LZ4_IMAGE_MAGIC3	'D'
+
+/** check if the .data image at "rom" of "size" bytes is compressed
+ * Returns the size of the compressed data following the header, or 0.
+ */
+size_t lz4_image_check(const void *rom, size_t size);
+
+/** decompress a chunk of LZ4 block data
+ *
+ * Decompresses "src_size" bytes at "src" into "dst_size" bytes at "dst",
+ * starting at the positions "*src_pos" and "*dst_pos". Stops after at least
+ * "batch" bytes were written and updates the positions. The matches refer
+ * to already decompressed data in "dst", so a stopped decompression can be
+ * continued later with the updated positions.
+ *
+ * Returns 1 when the decompression is complete, 0 when it is stopped,
+ * and -1 if the data is corrupt or does not fill "dst_size" bytes exactly.
+ */
+int lz4_unpack(const uint8_t *src, size_t src_size, size_t *src_pos,
+               uint8_t *dst, size_t dst_size, size_t *dst_pos,
+               size_t batch);
+
+/** decompress a .data image in one go, if it is compressed
+ * Returns 1 if the image was compressed and is now unpacked to "ram",
+ * 0 if the image is not compressed, and -1 if the image is corrupt.
+ */
+int lz4_image_unpack(void *ram, const void *rom, size_t size);
+
+#endif
@@ -23,6 +23,9 @@ void part_init_rest(unsigned int start_condition);
 /** startup all partitions */
 void part_start_all(unsigned int cpu_id);
 
+/** start a deferred partition that is due (called from scheduler when idle) */
+int part_start_deferred(time_t now);
+
 /** get partition configuration */
 static inline const struct part_cfg *part_get_part_cfg(unsigned int part_id)
 {
@@ -35,7 +38,10 @@ static inline const struct part_cfg *part_get_part_cfg(unsigned int part_id)
 /** trigger a change of the partition state (delayed until scheduling) */
 void part_delayed_state_change(struct part *part, unsigned int new_mode);
 /** do a change of the partition state (called from scheduler) */
-void part_state_change(struct part *part);
+int part_state_change(struct part *part);
+
+/** upper bound of objects torn down in one step of a partition shutdown */
+#define PART_SHUTDOWN_BATCH	16
 
 
 /** Get the caller's partition operating mode */
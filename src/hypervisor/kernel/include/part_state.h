@@ -18,6 +18,7 @@ struct counter_access;
 struct shm_access;
 struct kldd_cfg;
 struct ipev_cfg;
+struct ipev_group_cfg;
 struct schedtab;
 struct alarm;
 struct part;
@@ -32,6 +33,7 @@ struct rpc_cfg;
 /* partition flags */
 #define PART_FLAG_PRIVILEGED			0x00000001
 #define PART_FLAG_RESTARTABLE			0x00000002
+#define PART_FLAG_DEFERRED_START		0x00000004
 
 /** Number of memory ranges */
 #define NUM_MEM_RANGES	4
@@ -42,6 +44,9 @@ struct mem_range {
 	addr_t end;
 };
 
+/** Bytes of a compressed .data image unpacked per kernel entry */
+#define PART_UNPACK_BATCH	4096
+
 /** static partition configuration:
  */
 struct part_cfg {
@@ -73,6 +78,9 @@ struct part_cfg {
 	/* pointer to partition's inter-partition events */
 	const struct ipev_cfg *ipevs;
 
+	/* pointer to partition's inter-partition event groups */
+	const struct ipev_group_cfg *ipev_groups;
+
 	/* partition specific MPU config */
 	const struct arch_mpu_part_cfg *mpu_part_cfg;
 
@@ -82,6 +90,8 @@ struct part_cfg {
 	/* partition scheduling */
 	time_t period;
 	time_t duration;		/* for ARINC information purposes */
+	/* earliest start of a PART_FLAG_DEFERRED_START partition (after the epoch) */
+	time_t start_delay;
 
 	/* scheduling data in user space */
 	user_sched_state_t *user_sched_state;
@@ -104,7 +114,7 @@ struct part_cfg {
 	uint8_t tp_id;			/* associated time partition */
 
 	uint16_t num_rpcs;
-	uint16_t padding;
+	uint16_t num_ipev_groups;
 
 	uint16_t init_hook_id;	/* partition startup hook (local task ID, always used) */
 	uint16_t error_hook_id;	/* error and protection hook (local task ID, 0xffff if not used) */
@@ -119,6 +129,11 @@ struct part_cfg {
 
 	struct mem_range mem_ranges[NUM_MEM_RANGES];
 
+	/* .data image in ROM and RAM, unpacked by the kernel if compressed (0 if not used) */
+	addr_t data_rom;
+	addr_t data_ram;
+	size_t data_size;
+
 	const char *name;
 
 	/* addresses of small data areas */
@@ -146,13 +161,36 @@ struct part {
 	uint8_t pending_mode_change;
 	/** new operating mode to enter */
 	uint8_t new_operating_mode;
-	uint16_t padding;
+	/** if non-zero, a partition shutdown is in progress */
+	uint8_t shutdown_pending;
+	/** if non-zero, the compressed .data image is being unpacked */
+	uint8_t unpack_pending;
+	/** if non-zero, the partition waits for its deferred start */
+	uint8_t deferred_start;
+	/** if non-zero, the kernel unpacked the .data image for the next start */
+	uint8_t data_unpacked;
+	uint8_t padding[2];
 
 	/** single linked list: partitions with pending mode changes */
 	struct part *next_pending_mode_change;
+	/** progress of a shutdown: alarms, schedule tables, tasks, wait queues */
+	unsigned int shutdown_pos;
+	/** progress of unpacking the .data image: compressed and unpacked bytes */
+	unsigned int unpack_src;
+	unsigned int unpack_dst;
+	/** time spent unpacking the .data image at the last start */
+	time_t unpack_time;
+	/** boot log: first start and first NORMAL mode (cycles, see bootlog.h) */
+	uint32_t boot_start;
+	uint32_t boot_normal;
 
 	/** last scheduled real task (may be current one or NULL for idle) */
 	struct task *last_real_task;
+
+	/** accumulated execution time of all tasks in the partition */
+	time_t exec_time;
+	/** part of exec_time consumed in other time partitions' idle time */
+	time_t slack_time;
 };
 
 #endif
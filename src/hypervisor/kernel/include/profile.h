@@ -0,0 +1,82 @@
+/*
+ * profile.h
+ *
+ * Sampling profiler based on performance counter overflow interrupts.
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include <stdint.h>
+#include <hv_compiler.h>
+
+/*
+ * The profiler is enabled at compile time by building with PROFILE=yes.
+ * A performance counter is programmed to overflow every PROFILE_PERIOD
+ * events. On overflow, the interrupted user PC, the current task and
+ * partition are recorded into a per-CPU ring buffer in .bss.
+ *
+ * The overflow interrupt is a category 1 ISR that must be assigned to
+ * the board's performance monitor interrupt in the configuration, e.g.:
+ *
+ *   <isr name="PMU" cpu="0" vector="...">
+ *       <invoke entry="arch_profile_irq_handler" arg=""/>
+ *   </isr>
+ *
+ * Like the trace buffers, the sample buffers are retrieved from a memory
+ * dump of the symbol "profile_buf" and symbolized on the host with
+ * scripts/ab_profile_decode.pl against the kernel.map and app.map files.
+ *
+ * Currently, only ARMv7-A/R processors are supported.
+ */
+
+/** number of samples per CPU (must be a power of two) */
+#ifndef PROFILE_SAMPLES
+#define PROFILE_SAMPLES	1024
+#endif
+
+/** number of counted events between two samples */
+#ifndef PROFILE_PERIOD
+#define PROFILE_PERIOD	100000
+#endif
+
+/** magic in the header of each sample buffer: "PRF1" */
+#define PROFILE_MAGIC	0x50524631
+
+/** a sample (8 bytes) */
+struct profile_sample {
+	uint32_t pc;			/* interrupted program counter */
+	uint16_t task;			/* global task ID */
+	uint8_t part;			/* partition ID */
+	uint8_t cpu;			/* recording CPU */
+};
+
+/** per-CPU sample ring buffer */
+struct profile_buf {
+	uint32_t magic;			/* PROFILE_MAGIC */
+	uint16_t num_samples;	/* PROFILE_SAMPLES */
+	uint16_t sample_size;	/* sizeof(struct profile_sample) */
+	uint32_t count;			/* number of samples recorded so far (wraps) */
+	uint32_t period;		/* PROFILE_PERIOD */
+	struct profile_sample samples[PROFILE_SAMPLES];
+};
+
+#ifdef PROFILE
+
+/** initialize the sample buffer and start sampling on the current CPU */
+void profile_init(void);
+
+/** record a sample of the current task in the buffer of the current CPU */
+void profile_sample(unsigned long pc);
+
+#else
+
+static inline void profile_init(void)
+{
+}
+
+#endif
+
+#endif
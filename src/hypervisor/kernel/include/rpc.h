@@ -34,6 +34,6 @@ void rpc_next(struct task *receiver, struct rpc *rpc);
 void rpc_cancel(struct task *task);
 
 /** abort all queued RPC, called on partition shutdown */
-void rpc_abort(struct task *rpc_task, struct rpc *rpc);
+unsigned int rpc_abort(struct task *rpc_task, struct rpc *rpc, unsigned int max);
 
 #endif
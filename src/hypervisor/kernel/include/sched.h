@@ -23,14 +23,46 @@ struct tpschedule_cfg;
 extern const uint8_t num_cpus;
 /** Number of time partitions */
 extern const uint8_t num_timeparts;
+/** Time partitions that may reclaim idle time of other windows, in order */
+extern const uint8_t num_slack_timeparts;
+extern const uint8_t slack_timeparts[];
 
 /** initialize scheduler */
 void sched_init(void);
 /** start scheduling (called once at system start on each CPU) */
 void sched_start(void);
+/** synchronize the start of time partitioning on all CPUs */
+void sched_sync_start(void);
+/** common start of the first major frame on all CPUs */
+extern time_t sched_tp_epoch;
 
 /** insert a task at the tail of the ready queue */
 void sched_readyq_insert_tail(struct task *task);
+/** batch of tasks inserted into the ready queue at once
+ *
+ * Wake-up paths that wake multiple tasks add them with
+ * sched_readyq_batch_add() and update the scheduling state
+ * (next_prio and rescheduling) once in sched_readyq_batch_done().
+ */
+struct sched_batch {
+	/** time partition with pending scheduling update, or NULL */
+	struct timepart_state *timepart;
+	/** highest priority of the tasks added to the time partition */
+	unsigned int prio;
+};
+
+/** initialize an empty batch */
+static inline void sched_readyq_batch_init(struct sched_batch *batch)
+{
+	batch->timepart = NULL;
+	batch->prio = 0;
+}
+
+/** add a task at the tail of the ready queue as part of a batch */
+void sched_readyq_batch_add(struct sched_batch *batch, struct task *task);
+/** trigger necessary scheduling for all tasks added to a batch */
+void sched_readyq_batch_done(struct sched_batch *batch);
+
 /** insert a task at the head of the ready queue */
 void sched_readyq_insert_head(struct task *task);
 /** remove a task from the ready queue and put task into SUSPENDED state */
@@ -40,6 +72,9 @@ void sched_suspend(struct task *task);
 /** let current task wait with timeout */
 void sched_wait(struct task *task, unsigned int new_state, timeout_t timeout);
 
+/** ISR server: check the budget of a new activation */
+int sched_server_activate(struct task *task);
+
 /** start the deadline of a task relative to now */
 void sched_deadline_start(time_t now, struct task *task);
 /** change the deadline of a task to given expiry time */
@@ -60,6 +95,19 @@ __tc_fastcall struct arch_reg_frame *sched_schedule(void);
 /** alias to get the current partition configuration */
 #define current_part_cfg()			(arch_get_sched_state()->current_part_cfg)
 
+/** get the time partition of the current task (differs from the current
+ * window's time partition while the task reclaims slack)
+ */
+static inline struct timepart_state *current_timepart(void)
+{
+	struct sched_state *sched = current_sched_state();
+
+	if (sched->slack_timepart != NULL) {
+		return sched->slack_timepart;
+	}
+	return sched->timepart;
+}
+
 __tc_fastcall void sys_yield(void);
 __tc_fastcall void sys_schedule(void);
 __tc_fastcall void sys_fast_prio_sync(void);
@@ -73,6 +121,13 @@ __tc_fastcall void sys_gettime(void);
 /** Wait until next partition activation / release point. */
 __tc_fastcall void sys_wait_periodic(void);
 
+/** account execution time of the current activation on completion */
+void sched_activation_done(struct task *task);
+/** Get execution time statistics of a task in the caller's partition */
+__tc_fastcall void sys_task_exec_stats(unsigned int task_id, exec_stats_t *stats);
+/** Get execution time statistics of a task in any partition (privileged) */
+__tc_fastcall void sys_part_exec_stats(unsigned int part_id, unsigned int task_id, exec_stats_t *stats);
+
 /** Change time partition schedule on target CPU */
 __tc_fastcall void sys_schedule_change(unsigned int cpu_id, unsigned int schedule_id);
 void schedule_change(const struct tpschedule_cfg *next_tpschedule);
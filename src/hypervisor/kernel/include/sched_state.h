@@ -25,6 +25,7 @@ struct arch_fpu_frame;
 struct task;
 struct part_cfg;
 struct part;
+struct wq;
 
 /** upper limit of CPUs in the system (so we can use 8-bit indices) */
 #define MAX_CPUS	4
@@ -92,12 +93,21 @@ struct sched_state {
 	user_sched_state_t *user_sched_state;
 	/** current time partion */
 	struct timepart_state *timepart;
+	/** time partition reclaiming idle time in the current window, or NULL */
+	struct timepart_state *slack_timepart;
 
 	/** processor idle task (does not change after initialization) */
 	struct task *idle_task;
 
 	/** single linked list: partitions with pending mode changes */
 	struct part *pending_part_mode_change;
+	/** single linked list: wait queues with pending wake-ups */
+	struct wq *pending_wq_wake;
+
+	/** number of partitions waiting for their deferred start */
+	unsigned int num_deferred_parts;
+	/** earliest start time of a partition waiting for its deferred start */
+	time_t next_deferred_start;
 
 	/* time partition scheduling */
 
@@ -110,6 +120,11 @@ struct sched_state {
 	time_t last_tp_switch;
 	/** Time of next time partition switch */
 	time_t next_tp_switch;
+
+	/** Time of last context switch (for execution time accounting) */
+	time_t last_switch;
+	/** Time when the current task exhausts its execution budget */
+	time_t budget_expiry;
 } __aligned(SCHED_STATE_ALIGN);
 
 #endif
@@ -78,6 +78,35 @@ struct schedtab_cfg {
 #define SCHEDTAB_ACTION_LENGTHEN	5	/* OsScheduleTableMaxLengthen "time" */
 #define SCHEDTAB_ACTION_WRAP		6	/* wrap-around: continue at entry "next_idx" */
 #define SCHEDTAB_ACTION_START		7	/* start indicator (no arguments) */
+#define SCHEDTAB_ACTION_DISPATCH	8	/* apply all actions in "dispatch" */
+
+/** event action of a dispatch table, all event bits for a task merged */
+struct schedtab_event_cfg {
+	/** target task */
+	struct task *task;
+	/** events to set */
+	evmask_t mask;
+};
+
+/** pre-resolved actions of an expiry point, grouped by action type
+ *
+ * The tool emits a SCHEDTAB_ACTION_DISPATCH action instead of individual
+ * TASK, HOOK and EVENT actions if an expiry point has more than one action.
+ * The actions are applied in order: tasks, hooks, events (SWS_Os_00412).
+ */
+struct schedtab_dispatch_cfg {
+	/** number of tasks to activate */
+	uint8_t num_tasks;
+	/** number of hooks to activate (following the tasks in "tasks") */
+	uint8_t num_hooks;
+	/** number of event actions */
+	uint8_t num_events;
+	uint8_t padding;
+	/** tasks to activate, followed by the hooks */
+	struct task * const *tasks;
+	/** event actions */
+	const struct schedtab_event_cfg *events;
+};
 
 /** static scheduling table configuration */
 struct schedtab_action_cfg {
@@ -90,6 +119,8 @@ struct schedtab_action_cfg {
 	union {
 		/** associated task for various actions */
 		struct task *task;
+		/** dispatch table for SCHEDTAB_ACTION_DISPATCH */
+		const struct schedtab_dispatch_cfg *dispatch;
 		/** time value for time-specific actions */
 		uint32_t time;
 	} u;
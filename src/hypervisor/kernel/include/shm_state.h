@@ -26,6 +26,9 @@ struct shm_cfg {
 struct shm_access {
 	/** Related SHM */
 	const struct shm_cfg *shm_cfg;
+	/** if non-zero, the partition has write access to the SHM */
+	uint8_t write;
+	uint8_t padding[3];
 };
 
 #endif
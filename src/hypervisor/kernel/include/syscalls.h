@@ -66,5 +66,10 @@
 #define SYSCALL_SHUTDOWN	62
 #define SYSCALL_RPC_CALL	63
 #define SYSCALL_RPC_REPLY	64
+#define SYSCALL_TASK_EXEC_STATS	65
+#define SYSCALL_PART_EXEC_STATS	66
+#define SYSCALL_MULTICALL	67
+#define SYSCALL_IPEV_GROUP_SET	68
+#define SYSCALL_BOOTLOG	69
 
-#define NUM_SYSCALLS 65
+#define NUM_SYSCALLS 70
@@ -13,6 +13,9 @@
 #include <hv_types.h>
 #include <assert.h>
 
+/* forward */
+struct sched_batch;
+
 /** task configuration -> config.c */
 extern const uint16_t num_tasks;
 
@@ -47,14 +50,25 @@ static inline unsigned int task_get_global_id(struct task *task)
 }
 
 
+/** check if a task is an ISR server (ISR with budget and replenishment period) */
+static inline int task_is_server(const struct task_cfg *cfg)
+{
+	return TASK_TYPE_IS_ISR(cfg->cfgflags_type) && (cfg->period > 0) && (cfg->budget > 0);
+}
+
+
 /** check if a task activation will succeed or fail */
 unsigned int task_check_activate(struct task *task);
 /** activate task or hook */
 void task_do_activate(struct task *task);
+/** activate task or hook, scheduling deferred to the batch */
+void task_do_activate_batch(struct task *task, struct sched_batch *batch);
 /** internal preparation for activation of a task */
 void task_prepare(struct task *task);
 /** terminate a task */
 void task_terminate(struct task *task, int partition_shutdown);
+/** terminate a ready task the scheduler already removed from the ready queue */
+void task_terminate_dequeued(struct task *task);
 /** terminate self */
 void task_terminate_self(struct task *task);
 
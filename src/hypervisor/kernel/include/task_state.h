@@ -85,8 +85,8 @@ struct rpc;
  */
 #define TASK_FLAG_ELEV_PRIO			0x80	/* elevate priority on scheduling */
 #define TASK_FLAG_MAYBLOCK			0x40	/* indicate that a task may block */
-#define TASK_FLAG_UNUSED20			0x20	/* unused */
-#define TASK_FLAG_UNUSED10			0x10	/* unused */
+#define TASK_FLAG_THROTTLED			0x20	/* ISR server waits for budget replenishment */
+#define TASK_FLAG_DEFERRED			0x10	/* ISR server activation deferred to replenishment */
 #define TASK_FLAG_UNUSED08			0x08	/* unused */
 
 #define TASK_FLAG_TO_COPY			(TASK_FLAG_ELEV_PRIO | TASK_FLAG_MAYBLOCK)
@@ -135,8 +135,10 @@ struct task_cfg {
 	uint8_t base_prio;		/* base priority */
 	uint8_t elev_prio;		/* elevated priority (e.g. while holding resources) */
 
-	timeout_t period;		/* process period */
+	timeout_t period;		/* process period, replenishment period of ISR servers */
 	timeout_t capacity;		/* required time capacity, relative deadline since activation */
+	timeout_t budget;		/* execution budget per activation, or per period for ISR servers */
+	timeout_t timeframe;	/* minimum inter-arrival time of activations (timing protection) */
 
 	/* hardcoded entry points */
 	unsigned long entry;
@@ -170,12 +172,23 @@ struct task {
 	list_t waitq;			/* wait queue node in a double-linked list */
 	time_t expiry_time;		/* timeout expiry time */
 	time_t last_activation;	/* time of last planned activation */
+	time_t last_arrival;	/* time of last accepted activation request */
 
 	time_t deadline;		/* deadline expiry time */
 	list_t deadlineq;		/* deadline node in a double-linked list */
 
 	evmask_t ev_pending;	/* currently pending event */
 	struct task *rpc_task;	/* associated RPC receiver (for calling task) */
+
+	/* execution time accounting */
+	time_t exec_time;		/* accumulated execution time */
+	time_t activation_exec_time;	/* execution time of current activation */
+	time_t max_exec_time;	/* watermark: execution time per activation */
+	time_t max_response_time;	/* watermark: activation to completion */
+
+	/* ISR server */
+	time_t server_replenish;	/* time of next budget replenishment */
+	time_t server_exec_time;	/* exec_time at last budget replenishment */
 };
 
 #endif
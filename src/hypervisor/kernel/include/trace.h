@@ -0,0 +1,87 @@
+/*
+ * trace.h
+ *
+ * Kernel event tracing.
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <stdint.h>
+#include <hv_compiler.h>
+
+/*
+ * The trace buffer is enabled at compile time by building with TRACE=yes.
+ * Each CPU records fixed-size events into its own ring buffer in .bss.
+ * The buffers are not exported to user space, they are retrieved from a
+ * memory dump of the symbol "trace_buf" and decoded on the host with
+ * scripts/ab_trace_decode.pl.
+ *
+ * The timestamps are taken from a free running cycle counter
+ * (see arch_trace_timestamp()), which is not synchronized across CPUs.
+ */
+
+/** number of events per CPU (must be a power of two) */
+#ifndef TRACE_EVENTS
+#define TRACE_EVENTS	256
+#endif
+
+/** magic in the header of each trace buffer: "TRC1" */
+#define TRACE_MAGIC		0x54524331
+
+/** event types */
+#define TRACE_EV_NONE		0	/* unused slot */
+#define TRACE_EV_SWITCH		1	/* context switch: arg0 = part ID, arg1 = prev task, arg2 = next task (global IDs) */
+#define TRACE_EV_IRQ_ENTRY	2	/* IRQ entry: arg1 = vector */
+#define TRACE_EV_IRQ_EXIT	3	/* IRQ exit: arg1 = vector */
+#define TRACE_EV_SYSCALL	4	/* syscall entry: arg1 = syscall ID */
+#define TRACE_EV_TP_SWITCH	5	/* time partition switch: arg0 = window flags, arg1 = old TP, arg2 = new TP */
+#define TRACE_EV_IPI_SEND	6	/* IPI sent: arg1 = target CPU mask */
+#define TRACE_EV_IPI_RECV	7	/* IPI received: arg1 = source CPU */
+
+/** a trace event (16 bytes) */
+struct trace_event {
+	uint32_t timestamp;		/* lower 32 bits of the cycle counter */
+	uint8_t type;			/* event type */
+	uint8_t cpu;			/* recording CPU */
+	uint16_t arg0;			/* event specific argument */
+	uint32_t arg1;			/* event specific argument */
+	uint32_t arg2;			/* event specific argument */
+};
+
+/** per-CPU trace ring buffer */
+struct trace_buf {
+	uint32_t magic;			/* TRACE_MAGIC */
+	uint16_t num_events;	/* TRACE_EVENTS */
+	uint16_t event_size;	/* sizeof(struct trace_event) */
+	uint32_t count;			/* number of events recorded so far (wraps) */
+	uint32_t padding;
+	struct trace_event events[TRACE_EVENTS];
+};
+
+#ifdef TRACE
+
+/** initialize the trace buffer of the current CPU */
+void trace_init(void);
+
+/** record an event in the trace buffer of the current CPU */
+void trace_event(unsigned int type, unsigned int arg0, unsigned long arg1, unsigned long arg2);
+
+/** record a syscall entry (called from the assembler syscall path) */
+void trace_syscall(unsigned long syscall_id);
+
+#else
+
+static inline void trace_init(void)
+{
+}
+
+static inline void trace_event(unsigned int type __unused, unsigned int arg0 __unused, unsigned long arg1 __unused, unsigned long arg2 __unused)
+{
+}
+
+#endif
+
+#endif
@@ -12,6 +12,9 @@
 #include <wq_state.h>
 #include <hv_types.h>
 
+/* forward */
+struct sched_state;
+
 /** static configuration -> config.c */
 extern const struct wq_cfg wq_cfg[];
 
@@ -24,6 +27,9 @@ void wq_close(struct wq *wq);
 /** wake up to "count" tasks on wait queue */
 void wq_wake(struct wq *wq, unsigned int count);
 
+/** continue deferred wake-ups (called from scheduler) */
+void wq_do_pending_wakes(struct sched_state *sched);
+
 /** Set wait queue discipline */
 __tc_fastcall void sys_wq_set_discipline(
 	unsigned int wq_id,
@@ -30,6 +30,9 @@
 /** max number of waiting tasks on a wait queue (for 8-bit indices) */
 #define NUM_WAITERS	255
 
+/** upper bound of waiters woken in one kernel entry, the rest is deferred */
+#define WQ_WAKE_BATCH	16
+
 /** Wait queue state */
 #define WQ_STATE_CLOSED			0
 #define WQ_STATE_READY			1
@@ -59,7 +62,13 @@ struct wq {
 	uint8_t state;
 	/** associated processor */
 	uint8_t cpu_id;
-	uint8_t padding;
+	/** number of deferred wake-ups, non-zero if wake_mark is enqueued */
+	uint8_t wake_remaining;
+
+	/** marker in waitq: the deferred wake-ups stop at this node */
+	list_t wake_mark;
+	/** single linked list: wait queues with pending wake-ups */
+	struct wq *next_pending_wake;
 };
 
 #endif
@@ -436,8 +436,8 @@ void alarm_expire(struct alarm *alm)
 		if (err == E_OK) {
 			task_do_activate(alm_cfg->u.task);
 		} else {
-			assert(err == E_OS_LIMIT);
-			hm_async_task_error(alm_cfg->u.task->cfg, HM_ERROR_TASK_ACTIVATION_ERROR, 0);
+			assert((err == E_OS_LIMIT) || (err == E_OS_PROTECTION_ARRIVAL));
+			hm_async_task_error(alm_cfg->u.task->cfg, HM_ERROR_TASK_ACTIVATION_ERROR, err);
 		}
 		break;
 
@@ -452,7 +452,7 @@ void alarm_expire(struct alarm *alm)
 		if (err == E_OK) {
 			task_do_activate(alm_cfg->u.task);
 		} else {
-			assert(err == E_OS_LIMIT);
+			assert((err == E_OS_LIMIT) || (err == E_OS_PROTECTION_ARRIVAL));
 			/* no error reported here */
 		}
 		break;
@@ -0,0 +1,145 @@
+/*
+ * bootlog.c
+ *
+ * Boot-time profiling of the kernel and partition initialization.
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#include <kernel.h>
+#include <assert.h>
+#include <arch.h>
+#include <sched.h>
+#include <part.h>
+#include <hv_error.h>
+#include <bootlog.h>
+
+#ifdef SMP
+#define NUM_BOOTLOG_BASES MAX_CPUS
+#else
+#define NUM_BOOTLOG_BASES 1
+#endif
+
+/** cycle counter at kernel entry, per CPU */
+static uint32_t bootlog_base[NUM_BOOTLOG_BASES];
+
+/** kernel boot phases, relative to the kernel entry on the first CPU */
+static uint32_t bootlog_phases[BOOTLOG_NUM_PHASES];
+
+/** cycles since kernel entry on the current CPU, never zero */
+static inline uint32_t bootlog_now(void)
+{
+	uint32_t t;
+
+	t = arch_trace_timestamp() - bootlog_base[arch_cpu_id()];
+	/* zero means "not reached yet" for the partition stamps */
+	return t != 0 ? t : 1;
+}
+
+/** record the kernel entry on the current CPU (called first in kernel_main) */
+__init void bootlog_init(void)
+{
+	unsigned int cpu;
+
+	cpu = arch_cpu_id();
+	assert(cpu < NUM_BOOTLOG_BASES);
+	bootlog_base[cpu] = arch_trace_timestamp();
+	if (cpu == 0) {
+		bootlog_phases[BOOTLOG_KERNEL_MAIN] = 0;
+	}
+}
+
+/** record the entry of a boot phase (only recorded on the first CPU) */
+__init void bootlog_phase(unsigned int phase)
+{
+	assert(phase < BOOTLOG_NUM_PHASES);
+
+	if (arch_cpu_id() == 0) {
+		bootlog_phases[phase] = bootlog_now();
+	}
+}
+
+/** record the start of a partition */
+void bootlog_part_start(struct part *part)
+{
+	assert(part != NULL);
+
+	if (part->boot_start == 0) {
+		part->boot_start = bootlog_now();
+	}
+}
+
+/** record the first transition of a partition to NORMAL mode */
+void bootlog_part_normal(struct part *part)
+{
+	assert(part != NULL);
+
+	if (part->boot_normal == 0) {
+		part->boot_normal = bootlog_now();
+		Vprintf("* partition %d '%s': NORMAL mode after %u cycles (init %u cycles)\n",
+		        part->cfg->part_id, part->cfg->name, part->boot_normal,
+		        part->boot_normal - part->boot_start);
+	}
+}
+
+/** print the boot phases recorded so far */
+__init void bootlog_print(void)
+{
+#ifdef VERBOSE
+	static const char *const names[BOOTLOG_NUM_PHASES] = {
+		"kernel_main     ",
+		"further_init    ",
+		"part_init       ",
+		"obj_init        ",
+		"startup_complete",
+		"sync_start      ",
+		"part_start      ",
+		"running         ",
+	};
+	unsigned int i;
+
+	Vprintf("* boot phases on core 0        cycles      delta\n");
+	for (i = 0; i <= BOOTLOG_STARTUP_COMPLETE; i++) {
+		Vprintf("  %s %10u %10u\n", names[i], bootlog_phases[i],
+		        (i == 0) ? 0 : bootlog_phases[i] - bootlog_phases[i - 1]);
+	}
+#endif
+}
+
+/** system call to retrieve the boot log and the boot times of a partition */
+void sys_bootlog(unsigned int part_id, bootlog_t *log)
+{
+	const struct part_cfg *part_cfg;
+	unsigned int part_limit;
+	unsigned int err;
+	unsigned int i;
+
+	if (!(current_part_cfg()->flags & PART_FLAG_PRIVILEGED)) {
+		SET_RET(E_OS_ACCESS);	/* ERRNO: partition privilege error */
+		return;
+	}
+
+	/* skip idle partitions, these are invisible to the user */
+	assert(num_partitions >= num_cpus);
+	part_limit = num_partitions - num_cpus;
+	if (part_id >= part_limit) {
+		SET_RET(E_OS_ID);
+		return;
+	}
+	part_id += num_cpus;
+
+	err = kernel_check_user_addr(log, sizeof(*log));
+	if ((err != E_OK) || (((addr_t)log & (sizeof(uint32_t) - 1)) != 0)) {
+		SET_RET(E_OS_ILLEGAL_ADDRESS);
+		return;
+	}
+
+	for (i = 0; i < BOOTLOG_NUM_PHASES; i++) {
+		log->phase[i] = bootlog_phases[i];
+	}
+	part_cfg = part_get_part_cfg(part_id);
+	log->part_start = part_cfg->part->boot_start;
+	log->part_normal = part_cfg->part->boot_normal;
+
+	SET_RET(E_OK);
+}
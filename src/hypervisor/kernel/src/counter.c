@@ -14,6 +14,9 @@
 #include <sched.h>
 #include <part.h>
 #include <ipi.h>
+#include <core.h>
+#include <board.h>
+#include <system_timer.h>
 
 
 /** initialize all counters
@@ -61,6 +64,59 @@ __init void counter_init_all_per_cpu(void)
 	}
 }
 
+/** publish tick count and counter values to the current partition's user space
+ *
+ * NOTE: partitions are bound to a CPU, so the user space reader can only
+ * observe an update if it was preempted while reading.
+ */
+void counter_publish_time(void)
+{
+	const struct counter_cfg *ctr_cfg;
+	const struct part_cfg *part_cfg;
+	struct sched_state *sched;
+	user_time_state_t *ts;
+	uint32_t ctr_valid;
+	unsigned int cpu;
+	unsigned int i;
+
+	cpu = arch_cpu_id();
+	sched = current_sched_state();
+	part_cfg = sched->current_part_cfg;
+	assert(part_cfg != NULL);
+	assert(sched->user_sched_state != NULL);
+	ts = &sched->user_sched_state->time;
+
+	ts->seq++;
+	barrier();
+
+	ts->resolution = board_timer_resolution;
+	ts->ticks = core_cfg[cpu].core_state->system_timer_count;
+
+	ctr_valid = 0;
+	for (i = 0; (i < part_cfg->num_ctr_accs) && (i < USER_TIME_NUM_CTRS); i++) {
+		ctr_cfg = part_cfg->ctr_accs[i].counter_cfg;
+
+		/* hardware counters must be queried, cross-core counters change
+		 * without notice, so both are left to the system call
+		 */
+		if (ctr_cfg->cpu_id != cpu) {
+			continue;
+		}
+		if ((ctr_cfg->type == COUNTER_TYPE_HW) &&
+		    (ctr_cfg->query != system_timer_query)) {
+			continue;
+		}
+
+		ts->ctr[i].value = ctr_cfg->counter->current;
+		ts->ctr[i].maxallowedvalue = ctr_cfg->maxallowedvalue;
+		ctr_valid |= 1u << i;
+	}
+	ts->ctr_valid = ctr_valid;
+
+	barrier();
+	ts->seq++;
+}
+
 /** Increment (software) counter by one tick */
 void sys_ctr_increment(unsigned int ctr_id)
 {
@@ -225,4 +281,7 @@ void kernel_increment_counter(const struct counter_cfg *ctr_cfg, ctrtick_t incre
 		alm->expiry = ctr_add(alm->expiry, alm->cycle, ctr_cfg->maxallowedvalue);
 		alarm_enqueue(alm, ctr_cfg);
 	}
+
+	/* update the user visible counter values */
+	counter_publish_time();
 }
@@ -192,3 +192,74 @@ void sys_ipev_set(unsigned int ipev_id)
 
 	(void)ev_set(task, mask);
 }
+
+/** set events in the IPEV group targets of the current CPU
+ *
+ * NOTE: like the NOERR IPI variant, errors are not reported to the targets.
+ */
+void ipev_group_signal(const struct ipev_group_cpu_cfg *group_cpu)
+{
+	const struct task_cfg *task_cfg;
+	const struct ipev_cfg *ipev;
+	unsigned int operating_mode;
+	unsigned int i;
+
+	assert(group_cpu != NULL);
+
+	for (i = 0; i < group_cpu->num_targets; i++) {
+		ipev = &group_cpu->targets[i];
+
+		assert(ipev->global_task_id < num_tasks);
+		task_cfg = task_get_task_cfg(ipev->global_task_id);
+		assert(task_cfg->cpu_id == arch_cpu_id());
+		assert(task_cfg->task != NULL);
+		assert(TASK_MAY_BLOCK(task_cfg->task->flags_state));
+
+		operating_mode = task_cfg->part_cfg->part->operating_mode;
+		if (operating_mode == PART_OPERATING_MODE_IDLE) {
+			/* target partition not ready to receive */
+			continue;
+		}
+
+		assert(ipev->mask_bit < 32);	/* 32 for 32 bits */
+		(void)ev_set(task_cfg->task, 1U << ipev->mask_bit);
+	}
+}
+
+void sys_ipev_group_set(unsigned int group_id)
+{
+	const struct ipev_group_cpu_cfg *group_cpu;
+	const struct ipev_group_cfg *group;
+	const struct part_cfg *part_cfg;
+	unsigned int cpu;
+
+	part_cfg = current_part_cfg();
+	assert(part_cfg != NULL);
+
+	if (group_id >= part_cfg->num_ipev_groups) {
+		SET_RET(E_OS_ID);
+		return;
+	}
+
+	group = &part_cfg->ipev_groups[group_id];
+
+	/* see sys_ipev_set() */
+	SET_RET(E_OK);
+
+	/* one IPI action for all targets on a remote CPU */
+	for (cpu = 0; cpu < num_cpus; cpu++) {
+		group_cpu = &group->cpu[cpu];
+		if (group_cpu->num_targets == 0) {
+			continue;
+		}
+
+#ifdef SMP
+		if (cpu != arch_cpu_id()) {
+			ipi_enqueue(cpu, group_cpu, IPI_ACTION_IPEV_GROUP, 0);
+			continue;
+		}
+#endif
+
+		ipev_group_signal(group_cpu);
+	}
+}
@@ -57,6 +57,7 @@ static const char *hm_strerror(unsigned int hm_error_id)
 	case HM_ERROR_DEADLINE_MISSED:			return "DEADLINE_MISSED";
 	case HM_ERROR_TASK_ACTIVATION_ERROR:	return "TASK_ACTIVATION_ERROR";
 	case HM_ERROR_TASK_STATE_ERROR:			return "TASK_STATE_ERROR";
+	case HM_ERROR_BUDGET_EXCEEDED:			return "BUDGET_EXCEEDED";
 	case HM_ERROR_ABORT:					return "ABORT";
 	case HM_ERROR_USER_CONFIG_ERROR:		return "USER_CONFIG_ERROR";
 	case HM_ERROR_USER_APPLICATION_ERROR:	return "USER_APPLICATION_ERROR";
@@ -23,6 +23,7 @@
 #include <part.h>
 #include <wq.h>
 #include <hm.h>
+#include <trace.h>
 
 /* NOTE: no global init function required -- initially, all counters are zero! */
 
@@ -134,8 +135,8 @@ static inline void ipi_do_action(struct ipi_action *action)
 		if (err == E_OK) {
 			task_do_activate(action->u.task);
 		} else {
-			assert(err == E_OS_LIMIT);
-			hm_async_task_error(action->u.task->cfg, HM_ERROR_TASK_ACTIVATION_ERROR, 0);
+			assert((err == E_OS_LIMIT) || (err == E_OS_PROTECTION_ARRIVAL));
+			hm_async_task_error(action->u.task->cfg, HM_ERROR_TASK_ACTIVATION_ERROR, err);
 		}
 		break;
 
@@ -144,7 +145,7 @@ static inline void ipi_do_action(struct ipi_action *action)
 		if (err == E_OK) {
 			task_do_activate(action->u.task);
 		} else {
-			assert(err == E_OS_LIMIT);
+			assert((err == E_OS_LIMIT) || (err == E_OS_PROTECTION_ARRIVAL));
 			/* no error reported here */
 		}
 		break;
@@ -166,6 +167,11 @@ static inline void ipi_do_action(struct ipi_action *action)
 		schedule_change(action->u.next_tpschedule);
 		break;
 
+	case IPI_ACTION_IPEV_GROUP:
+		/* target partitions are checked for each target */
+		ipev_group_signal(action->u.ipev_group_cpu);
+		break;
+
 	default:
 		assert(0);
 		break;
@@ -184,6 +190,8 @@ void kernel_ipi_handle(unsigned int target_cpu, unsigned int source_cpu)
 	assert(source_cpu < num_cpus);
 	assert(target_cpu != source_cpu);
 
+	trace_event(TRACE_EV_IPI_RECV, 0, source_cpu, 0);
+
 	target_state = ipi_state(target_cpu);
 	source_state = ipi_state(source_cpu);
 	actions = ipi_actions(target_cpu, source_cpu);
@@ -224,6 +232,7 @@ void ipi_send(uint32_t cpu_mask)
 	assert((cpu_mask & (1U << arch_cpu_id())) == 0);
 	assert(cpu_mask != 0);
 
+	trace_event(TRACE_EV_IPI_SEND, 0, cpu_mask, 0);
 	board_ipi_broadcast(cpu_mask);
 
 	me = check_cpu = arch_cpu_id();
@@ -12,6 +12,8 @@
 #include <task.h>
 #include <kldd.h>
 #include <sched.h>
+#include <shm.h>
+#include <arch.h>
 #include <hv_error.h>
 
 
@@ -35,6 +37,55 @@ void sys_kldd_call(unsigned int kldd_id, unsigned long arg1,
 	SET_RET(err);
 }
 
+/** KLDD for data cache maintenance of a memory range of the caller
+ *
+ * The range of \a size bytes at \a addr must be located in the memory of the
+ * caller's partition or in an SHM the partition has access to. Invalidation
+ * requires write access to the SHM, as it discards data of other partitions.
+ * \a op is one of CACHE_OP_CLEAN, CACHE_OP_INVAL or CACHE_OP_FLUSH.
+ * A call covers at most CACHE_OP_MAX_SIZE bytes to bound the time spent in
+ * the kernel, larger ranges fail with E_OS_LIMIT. Configure the KLDD as:
+ *
+ *   <kldd name="cache" entry="kldd_cache_range" arg=""/>
+ */
+unsigned int kldd_cache_range(void *arg0 __unused, unsigned long addr,
+                              unsigned long size, unsigned long op)
+{
+	const struct part_cfg *part_cfg;
+	const struct shm_cfg *shm;
+	unsigned int i;
+
+	if ((op != CACHE_OP_CLEAN) && (op != CACHE_OP_INVAL) && (op != CACHE_OP_FLUSH)) {
+		return E_OS_VALUE;
+	}
+	if ((size == 0) || (addr + size < addr)) {
+		return E_OS_VALUE;
+	}
+	if (size > CACHE_OP_MAX_SIZE) {
+		return E_OS_LIMIT;
+	}
+
+	if (kernel_check_user_addr((void *)addr, size) == E_OK) {
+		arch_cache_range(op, addr, size);
+		return E_OK;
+	}
+
+	part_cfg = current_part_cfg();
+	for (i = 0; i < part_cfg->num_shm_accs; i++) {
+		shm = part_cfg->shm_accs[i].shm_cfg;
+		if ((addr < shm->base) || (addr + size > shm->base + shm->size)) {
+			continue;
+		}
+		if ((op == CACHE_OP_INVAL) && !part_cfg->shm_accs[i].write) {
+			return E_OS_ACCESS;
+		}
+		arch_cache_range(op, addr, size);
+		return E_OK;
+	}
+
+	return E_OS_ILLEGAL_ADDRESS;
+}
+
 
 /////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////
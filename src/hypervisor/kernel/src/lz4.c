@@ -0,0 +1,157 @@
+/*
+ * lz4.c
+ *
+ * Decompressor for LZ4 compressed .data images in ROM.
+ *
+ * The code must not use any global data, see lz4.h.
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#include <kernel.h>
+#include <lz4.h>
+
+
+/** read a 32-bit little endian value */
+static inline uint32_t lz4_le32(const uint8_t *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/** check if the .data image at "rom" of "size" bytes is compressed */
+size_t lz4_image_check(const void *rom, size_t size)
+{
+	const uint8_t *hdr = rom;
+	size_t comp_size;
+
+	if (size < LZ4_IMAGE_HDR_SIZE) {
+		return 0;
+	}
+
+	if ((hdr[0] != LZ4_IMAGE_MAGIC0) || (hdr[1] != LZ4_IMAGE_MAGIC1) ||
+	    (hdr[2] != LZ4_IMAGE_MAGIC2) || (hdr[3] != LZ4_IMAGE_MAGIC3)) {
+		return 0;
+	}
+
+	/* the compressed image must fit into the space of the .data image */
+	comp_size = lz4_le32(&hdr[4]);
+	if ((lz4_le32(&hdr[8]) != size) ||
+	    (comp_size > size - LZ4_IMAGE_HDR_SIZE)) {
+		return 0;
+	}
+
+	return comp_size;
+}
+
+/** read the extension bytes of a literal or match length */
+static inline size_t lz4_len(const uint8_t *src, size_t src_size, size_t *pos, size_t len)
+{
+	unsigned int b;
+
+	do {
+		if (*pos >= src_size) {
+			break;
+		}
+		b = src[(*pos)++];
+		len += b;
+	} while (b == 255);
+
+	return len;
+}
+
+/** decompress a chunk of LZ4 block data */
+int lz4_unpack(const uint8_t *src, size_t src_size, size_t *src_pos,
+               uint8_t *dst, size_t dst_size, size_t *dst_pos,
+               size_t batch)
+{
+	unsigned int token;
+	size_t offset;
+	size_t stop;
+	size_t len;
+	size_t s;
+	size_t d;
+
+	s = *src_pos;
+	d = *dst_pos;
+	stop = d + batch;
+
+	while (s < src_size) {
+		if (d >= stop) {
+			/* continue later */
+			*src_pos = s;
+			*dst_pos = d;
+			return 0;
+		}
+
+		/* a sequence: token, literals, match offset, match */
+		token = src[s++];
+
+		len = token >> 4;
+		if (len == 15) {
+			len = lz4_len(src, src_size, &s, len);
+		}
+		if ((len > src_size - s) || (len > dst_size - d)) {
+			goto corrupt;
+		}
+		while (len-- > 0) {
+			dst[d++] = src[s++];
+		}
+
+		/* the last sequence ends after the literals */
+		if (s >= src_size) {
+			break;
+		}
+
+		if (2 > src_size - s) {
+			goto corrupt;
+		}
+		offset = src[s] | (src[s + 1] << 8);
+		s += 2;
+
+		len = token & 15;
+		if (len == 15) {
+			len = lz4_len(src, src_size, &s, len);
+		}
+		len += 4;
+		if ((offset == 0) || (offset > d) || (len > dst_size - d)) {
+			goto corrupt;
+		}
+		/* the match may overlap with the bytes being written */
+		while (len-- > 0) {
+			dst[d] = dst[d - offset];
+			d++;
+		}
+	}
+
+	/* the data must fill the destination exactly */
+	if (d != dst_size) {
+		goto corrupt;
+	}
+
+	*src_pos = s;
+	*dst_pos = d;
+	return 1;
+
+corrupt:
+	*src_pos = s;
+	*dst_pos = d;
+	return -1;
+}
+
+/** decompress a .data image in one go, if it is compressed */
+int lz4_image_unpack(void *ram, const void *rom, size_t size)
+{
+	size_t comp_size;
+	size_t src_pos;
+	size_t dst_pos;
+
+	comp_size = lz4_image_check(rom, size);
+	if (comp_size == 0) {
+		return 0;
+	}
+
+	src_pos = 0;
+	dst_pos = 0;
+	return lz4_unpack((const uint8_t *)rom + LZ4_IMAGE_HDR_SIZE, comp_size, &src_pos,
+	                  ram, size, &dst_pos, size);
+}
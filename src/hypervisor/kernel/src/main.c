@@ -21,6 +21,9 @@
 #include <wq.h>
 #include <mpu.h>
 #include <arch_mpu.h>
+#include <trace.h>
+#include <profile.h>
+#include <bootlog.h>
 
 
 /* forward declaration */
@@ -31,6 +34,10 @@ static int boot_hm_restart;
 /** kernel entry function */
 __init void kernel_main(int hm_restart)
 {
+	/* start the cycle counter for the boot log */
+	arch_init_cycle_counter();
+	bootlog_init();
+
 	if (arch_cpu_id() == 0) {
 		/* initialize kernel subsystems, part #1 */
 		sched_init();
@@ -52,9 +59,12 @@ __init void kernel_main(int hm_restart)
 __init static void further_init(void *stack __unused)
 {
 	VVprintf("* cpu %d is now on the kernel stack %p ...\n", arch_cpu_id(), stack);
+	bootlog_phase(BOOTLOG_FURTHER_INIT);
 
-	/* initialize scheduling on this CPU */
+	/* initialize scheduling, tracing and profiling on this CPU */
 	sched_start();
+	trace_init();
+	profile_init();
 
 #ifdef SMP
 	if (arch_cpu_id() == 0) {
@@ -77,6 +87,12 @@ __init static void further_init(void *stack __unused)
 		printf(" SMP");
 #else
 		printf(" UP");
+#endif
+#ifdef TRACE
+		printf(" TRACE");
+#endif
+#ifdef PROFILE
+		printf(" PROFILE");
 #endif
 		printf("\n");
 
@@ -99,9 +115,11 @@ __init static void further_init(void *stack __unused)
 #endif
 
 		/* initialize kernel subsystems, part #2 */
+		bootlog_phase(BOOTLOG_PART_INIT);
 		part_init_rest(boot_hm_restart ?
 		               PART_START_CONDITION_HM_MODULE_RESTART :
 		               PART_START_CONDITION_NORMAL_START);
+		bootlog_phase(BOOTLOG_OBJ_INIT);
 		task_init_rest();
 		alarm_init_all();
 		schedtab_init_all();
@@ -112,6 +130,8 @@ __init static void further_init(void *stack __unused)
 		board_start_secondary_cpus();
 #endif
 
+		bootlog_phase(BOOTLOG_STARTUP_COMPLETE);
+		bootlog_print();
 		board_startup_complete();
 
 #ifdef SMP
@@ -120,12 +140,18 @@ __init static void further_init(void *stack __unused)
 	}
 #endif
 
+	/* wait for all CPUs and start time partitioning at a common epoch */
+	sched_sync_start();
+	bootlog_phase(BOOTLOG_SYNC_START);
+
 	/* initialize kernel subsystems, part #3: per core specific subsystems */
 	counter_init_all_per_cpu();
 
 	/* FINALLY: */
 	/* start all partitions of that core */
+	bootlog_phase(BOOTLOG_PART_START);
 	part_start_all(arch_cpu_id());
+	bootlog_phase(BOOTLOG_RUNNING);
 
 	/* on return, we leave to user space (or the idle task) */
 }
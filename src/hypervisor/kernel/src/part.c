@@ -18,6 +18,10 @@
 #include <board.h>
 #include <ipi.h>
 #include <rpc.h>
+#include <arch_mpu.h>
+#include <lz4.h>
+#include <bootlog.h>
+#include <hm.h>
 
 
 /* forward */
@@ -27,7 +31,10 @@ static void part_set_operating_mode_self(unsigned int new_mode);
 static void part_start(struct part *part, unsigned int new_mode);
 
 /** shutdown a partition (terminate all tasks) */
-static void part_shutdown(struct part *part);
+static int part_shutdown(struct part *part);
+
+/** unpack the compressed .data image of a partition */
+static int part_data_unpack(struct part *part);
 
 
 
@@ -112,6 +119,12 @@ __init void part_init_rest(unsigned int start_condition)
 		part->operating_mode = PART_OPERATING_MODE_IDLE;
 		part->warm_startable = 0;
 		part->start_condition = start_condition;
+		part->pending_mode_change = 0;
+		part->next_pending_mode_change = NULL;
+		part->unpack_pending = 0;
+		part->data_unpacked = 0;
+		part->unpack_time = 0;
+		part->deferred_start = 0;
 
 		assert(part_cfg->user_sched_state != NULL);
 
@@ -119,6 +132,9 @@ __init void part_init_rest(unsigned int start_condition)
 
 		assert(part_cfg->period > 0);
 		assert(part_cfg->duration > 0 && part_cfg->duration <= part_cfg->period);
+
+		assert((part_cfg->data_size == 0) ||
+		       ((part_cfg->data_rom != 0) && (part_cfg->data_ram != 0)));
 	}
 }
 
@@ -131,10 +147,15 @@ __init void part_init_rest(unsigned int start_condition)
 __init void part_start_all(unsigned int cpu_id __unused)
 {
 	const struct part_cfg *part_cfg;
+	struct sched_state *sched;
 	struct part *part;
 	unsigned int i;
+	int unpacked;
 	int start;
 
+	sched = current_sched_state();
+	assert(sched != NULL);
+
 	for (i = num_cpus; i < num_partitions; i++) {
 		part_cfg = part_get_part_cfg(i);
 
@@ -147,15 +168,113 @@ __init void part_start_all(unsigned int cpu_id __unused)
 		part = part_cfg->part;
 
 		start = (part_cfg->initial_operating_mode != PART_OPERATING_MODE_IDLE);
+		if (start && (part_cfg->flags & PART_FLAG_DEFERRED_START)) {
+			/* started later from the idle path, see part_start_deferred() */
+			Vprintf("* partition %d '%s': deferred in timepart %d on core %d ...\n",
+			        i, part_cfg->name, part_cfg->tp_id, cpu_id);
+			part->deferred_start = 1;
+			sched->num_deferred_parts++;
+			if (sched_tp_epoch + part_cfg->start_delay < sched->next_deferred_start) {
+				sched->next_deferred_start = sched_tp_epoch + part_cfg->start_delay;
+			}
+			continue;
+		}
+
 		Vprintf("* partition %d '%s': %s in timepart %d on core %d ...\n",
 		        i, part_cfg->name, start ? "starting" : "idle",
 		        part_cfg->tp_id, cpu_id);
 		if (start) {
+			if (part_cfg->data_size != 0) {
+				do {
+					/* boot time, no need for preemption points */
+					unpacked = part_data_unpack(part);
+				} while (unpacked == 0);
+				if (unpacked < 0) {
+					/* keep the partition in idle state */
+					continue;
+				}
+				if (part->unpack_dst != 0) {
+					Vprintf("  * .data image unpacked: %u -> %u bytes in %u us\n",
+					        part->unpack_src, part->unpack_dst,
+					        (unsigned int)(part->unpack_time / 1000));
+				}
+			}
 			part_start(part, part_cfg->initial_operating_mode);
 		}
 	}
 }
 
+/** cancel the deferred start of a partition */
+static void part_deferred_cancel(struct sched_state *sched, struct part *part)
+{
+	assert(sched != NULL);
+	assert(part != NULL);
+	assert(part->deferred_start != 0);
+	assert(sched->num_deferred_parts > 0);
+
+	part->deferred_start = 0;
+	sched->num_deferred_parts--;
+	if (sched->num_deferred_parts == 0) {
+		sched->next_deferred_start = INFINITY;
+	}
+}
+
+/** start a deferred partition that is due (called from scheduler when idle)
+ *
+ * The partitions of the core are started in configuration order, one per call,
+ * by a regular partition state change. The scheduler also calls this when a
+ * slack time partition reclaims the idle time. Returns non-zero if a partition
+ * was started.
+ */
+int part_start_deferred(time_t now)
+{
+	const struct part_cfg *part_cfg;
+	struct sched_state *sched;
+	struct part *part;
+	time_t next_start;
+	time_t start;
+	unsigned int i;
+
+	sched = current_sched_state();
+	assert(sched != NULL);
+	assert(sched->num_deferred_parts > 0);
+
+	if (now < sched->next_deferred_start) {
+		return 0;
+	}
+
+	next_start = INFINITY;
+	for (i = num_cpus; i < num_partitions; i++) {
+		part_cfg = part_get_part_cfg(i);
+#ifdef SMP
+		if (part_cfg->cpu_id != arch_cpu_id()) {
+			continue;
+		}
+#endif
+		part = part_cfg->part;
+		if (part->deferred_start == 0) {
+			continue;
+		}
+
+		start = sched_tp_epoch + part_cfg->start_delay;
+		if (now < start) {
+			if (start < next_start) {
+				next_start = start;
+			}
+			continue;
+		}
+
+		Vprintf("* partition %d '%s': deferred start\n", i, part_cfg->name);
+		part_deferred_cancel(sched, part);
+		part_delayed_state_change(part, part_cfg->initial_operating_mode);
+		return 1;
+	}
+
+	/* nothing due yet */
+	sched->next_deferred_start = next_start;
+	return 0;
+}
+
 /** start a partition (make all runnable tasks runnable) */
 static void part_start(struct part *part, unsigned int new_mode)
 {
@@ -172,10 +291,9 @@ static void part_start(struct part *part, unsigned int new_mode)
 	assert(new_mode != PART_OPERATING_MODE_IDLE);
 	assert(part->operating_mode == PART_OPERATING_MODE_IDLE);
 	part->operating_mode = new_mode;
+	bootlog_part_start(part);
 	/* set first partition activation into far future */
 	part->error_write_pos = 0;
-	part->pending_mode_change = 0;
-	part->next_pending_mode_change = NULL;
 	part->last_real_task = NULL;
 
 	for (i = 0; i < part_cfg->num_tasks; i++) {
@@ -198,8 +316,9 @@ static void part_start(struct part *part, unsigned int new_mode)
 	assert(task != NULL);
 	assert(TASK_STATE_IS_SUSPENDED(task->flags_state));
 
-	/* activate hook */
+	/* activate hook, tell the runtime if .data is already unpacked */
 	task_prepare(task);
+	arch_reg_frame_set_arg1(task->cfg->regs, part->data_unpacked);
 	sched_readyq_insert_tail(task);
 
 	/* the init hook never has a deadline */
@@ -208,26 +327,70 @@ static void part_start(struct part *part, unsigned int new_mode)
 	/* NOTE: OSEK autostarts are done by the init hook in user space */
 }
 
-/** shutdown a partition (kill all tasks) */
-static void part_shutdown(struct part *part)
+/** shutdown a partition (kill all tasks)
+ *
+ * The shutdown is done in steps of at most PART_SHUTDOWN_BATCH objects.
+ * Returns non-zero when the shutdown is complete. Otherwise, the scheduler
+ * continues on the next kernel entry, so pending interrupts are served in
+ * between. Ready tasks of the partition are terminated by the scheduler
+ * on sight meanwhile.
+ */
+static int part_shutdown(struct part *part)
 {
 	const struct part_cfg *part_cfg;
 	const struct task_cfg *cfg;
 	struct schedtab *schedtab;
+	unsigned int aborted;
+	unsigned int budget;
 	struct task *task;
 	struct alarm *alm;
-	unsigned int i;
+	unsigned int base;
+	unsigned int pos;
 
 	assert(part != NULL);
 	part_cfg = part->cfg;
 	assert(part_cfg != NULL);
 
-	assert(part->operating_mode != PART_OPERATING_MODE_IDLE);
-	part->operating_mode = PART_OPERATING_MODE_IDLE;
+	assert(part->operating_mode == PART_OPERATING_MODE_IDLE);
+	assert(part->shutdown_pending != 0);
 
-	/* terminate all tasks, ISR, hooks ... */
-	for (i = 0; i < part_cfg->num_tasks; i++) {
-		task = &part_cfg->tasks[i];
+	budget = PART_SHUTDOWN_BATCH;
+	pos = part->shutdown_pos;
+
+	/* cancel alarms ... */
+	while (pos < part_cfg->num_alarms) {
+		if (budget == 0) {
+			goto preempt;
+		}
+		alm = &part_cfg->alarms[pos];
+		if (alm->state != ALARM_STATE_IDLE) {
+			alarm_cancel(alm);
+		}
+		pos++;
+		budget--;
+	}
+	base = part_cfg->num_alarms;
+
+	/* ... and stop schedule tables ... */
+	while (pos - base < part_cfg->num_schedtabs) {
+		if (budget == 0) {
+			goto preempt;
+		}
+		schedtab = &part_cfg->schedtabs[pos - base];
+		if (schedtab->state != SCHEDTAB_STATE_STOPPED) {
+			schedtab_stop(schedtab);
+		}
+		pos++;
+		budget--;
+	}
+	base += part_cfg->num_schedtabs;
+
+	/* ... terminate all tasks, ISR, hooks ... */
+	while (pos - base < part_cfg->num_tasks) {
+		if (budget == 0) {
+			goto preempt;
+		}
+		task = &part_cfg->tasks[pos - base];
 		assert(task != NULL);
 
 		/* disable further interrupts */
@@ -236,34 +399,107 @@ static void part_shutdown(struct part *part)
 			board_irq_disable(cfg->irq);
 		}
 
-		/* abort all queued RPCs */
+		/* abort all queued RPCs, may take multiple steps */
 		if (cfg->rpc != NULL) {
-			rpc_abort(task, cfg->rpc);
+			aborted = rpc_abort(task, cfg->rpc, budget);
+			budget -= aborted;
+			if (budget == 0) {
+				goto preempt;
+			}
 		}
 
 		task_terminate(task, 1);
+		pos++;
+		budget--;
 	}
+	base += part_cfg->num_tasks;
 
-	/* ... and cancel alarms ... */
-	for (i = 0; i < part_cfg->num_alarms; i++) {
-		alm = &part_cfg->alarms[i];
-		if (alm->state != ALARM_STATE_IDLE) {
-			alarm_cancel(alm);
+	/* ... and close all wait queues */
+	while (pos - base < part_cfg->num_wqs) {
+		if (budget == 0) {
+			goto preempt;
 		}
+		wq_close(&part_cfg->wqs[pos - base]);
+		pos++;
+		budget--;
 	}
 
-	/* ... and stop schedule tables */
-	for (i = 0; i < part_cfg->num_schedtabs; i++) {
-		schedtab = &part_cfg->schedtabs[i];
-		if (schedtab->state != SCHEDTAB_STATE_STOPPED) {
-			schedtab_stop(schedtab);
-		}
+	return 1;
+
+preempt:
+	part->shutdown_pos = pos;
+	return 0;
+}
+
+/** unpack the compressed .data image of a partition
+ *
+ * The image is unpacked in steps of at most PART_UNPACK_BATCH bytes.
+ * Returns 1 when the image is unpacked, 0 to continue on the next call,
+ * or -1 if the image is corrupt. A corrupt image is reported to the system
+ * HM, and the partition must not be started. Images that are not
+ * compressed are left to the partition's runtime to copy.
+ * The partition's init hook gets data_unpacked as second argument.
+ */
+static int part_data_unpack(struct part *part)
+{
+	const struct part_cfg *current_cfg;
+	const struct part_cfg *part_cfg;
+	size_t comp_size;
+	size_t src_pos;
+	size_t dst_pos;
+	time_t start;
+	int done;
+
+	assert(part != NULL);
+	part_cfg = part->cfg;
+	assert(part_cfg != NULL);
+	assert(part_cfg->data_size != 0);
+
+	if (part->unpack_pending == 0) {
+		part->unpack_pending = 1;
+		part->data_unpacked = 0;
+		part->unpack_src = 0;
+		part->unpack_dst = 0;
+		part->unpack_time = 0;
+	}
+
+	/* the partition's memory is only accessible in its address space */
+	current_cfg = current_part_cfg();
+	if (current_cfg != part_cfg) {
+		arch_mpu_part_switch(part_cfg->mpu_part_cfg);
 	}
 
-	/* close all wait queues */
-	for (i = 0; i < part_cfg->num_wqs; i++) {
-		wq_close(&part_cfg->wqs[i]);
+	start = board_get_time();
+	done = 1;
+	comp_size = lz4_image_check((const void *)part_cfg->data_rom, part_cfg->data_size);
+	if (comp_size != 0) {
+		src_pos = part->unpack_src;
+		dst_pos = part->unpack_dst;
+		done = lz4_unpack((const uint8_t *)part_cfg->data_rom + LZ4_IMAGE_HDR_SIZE,
+		                  comp_size, &src_pos,
+		                  (uint8_t *)part_cfg->data_ram, part_cfg->data_size, &dst_pos,
+		                  PART_UNPACK_BATCH);
+		part->unpack_src = src_pos;
+		part->unpack_dst = dst_pos;
 	}
+	part->unpack_time += board_get_time() - start;
+
+	if (current_cfg != part_cfg) {
+		arch_mpu_part_switch(current_cfg->mpu_part_cfg);
+	}
+
+	if (done != 0) {
+		part->unpack_pending = 0;
+	}
+	if ((done > 0) && (comp_size != 0)) {
+		part->data_unpacked = 1;
+	}
+	if (done < 0) {
+		Vprintf("  * partition '%s': .data image corrupt at %u -> %u bytes\n",
+		        part_cfg->name, part->unpack_src, part->unpack_dst);
+		hm_system_error(HM_ERROR_DATA_MEMORY_ERROR, part_cfg->part_id);
+	}
+	return done;
 }
 
 /** system call to get the caller's partition operating mode */
@@ -421,6 +657,7 @@ static void part_set_operating_mode_self(unsigned int new_mode)
 		/* set new mode */
 		part->operating_mode = PART_OPERATING_MODE_NORMAL;
 		part->warm_startable = 1;
+		bootlog_part_normal(part);
 
 		SET_RET(E_OK);
 
@@ -527,7 +764,8 @@ void sys_part_set_operating_mode_ex(
 	part = part_cfg->part;
 	assert(part != NULL);
 
-	if (!(part_cfg->flags & PART_FLAG_RESTARTABLE)) {
+	/* a partition waiting for its deferred start can be started early */
+	if (!(part_cfg->flags & PART_FLAG_RESTARTABLE) && !part->deferred_start) {
 		SET_RET(E_OS_LIMIT);	/* ERRNO: idle partitions cannot be restarted */
 		return;
 	}
@@ -576,22 +814,35 @@ void part_delayed_state_change(
 		part->new_operating_mode = new_mode;
 
 		sched_enqueue_part_state_change(part);
+	} else {
+		/* a state change in progress continues with the latest mode */
+		part->new_operating_mode = new_mode;
 	}
 }
 
-/** do a change of the partition state (called from scheduler) */
-void part_state_change(
+/** do a change of the partition state (called from scheduler)
+ *
+ * Returns non-zero when the state change is complete. Otherwise, the
+ * partition is shut down in multiple steps and the scheduler calls again.
+ */
+int part_state_change(
 	struct part *part)
 {
 	unsigned int new_mode;
+	int unpacked;
 
 	assert(part != NULL);
 	assert(part->cfg->cpu_id == arch_cpu_id());
 
 	assert(part->pending_mode_change != 0);
-	part->pending_mode_change = 0;
 
 	new_mode = part->new_operating_mode;
+
+	/* an explicit mode change overrides a deferred start */
+	if (part->deferred_start != 0) {
+		part_deferred_cancel(current_sched_state(), part);
+	}
+
 	assert((new_mode == PART_OPERATING_MODE_IDLE) ||
 	       (new_mode == PART_OPERATING_MODE_COLD_START) ||
 	       (new_mode == PART_OPERATING_MODE_WARM_START));
@@ -608,17 +859,45 @@ void part_state_change(
 
 	/* shut down partition, if necessary */
 	if (part->operating_mode != PART_OPERATING_MODE_IDLE) {
-		part_shutdown(part);
+		part->operating_mode = PART_OPERATING_MODE_IDLE;
+		part->shutdown_pending = 1;
+		part->shutdown_pos = 0;
+	}
+	if (part->shutdown_pending != 0) {
+		if (!part_shutdown(part)) {
+			/* continue on next kernel entry */
+			return 0;
+		}
+		part->shutdown_pending = 0;
 	}
 	assert(part->operating_mode == PART_OPERATING_MODE_IDLE);
 	part->start_condition = PART_START_CONDITION_PARTITION_RESTART;
 
+	/* a compressed .data image is unpacked before the runtime starts */
+	if ((new_mode != PART_OPERATING_MODE_IDLE) && (part->cfg->data_size != 0)) {
+		unpacked = part_data_unpack(part);
+		if (unpacked == 0) {
+			/* continue on next kernel entry */
+			return 0;
+		}
+		if (unpacked < 0) {
+			/* corrupt image: keep the partition in idle state */
+			new_mode = PART_OPERATING_MODE_IDLE;
+		}
+	} else {
+		/* the mode changed to IDLE while unpacking: start over next time */
+		part->unpack_pending = 0;
+	}
+	part->pending_mode_change = 0;
+
 	/* ... and probably restart */
 	if ((new_mode == PART_OPERATING_MODE_COLD_START) ||
 	    (new_mode == PART_OPERATING_MODE_WARM_START)) {
 		part_start(part, new_mode);
 		assert(part->operating_mode != PART_OPERATING_MODE_IDLE);
 	}
+
+	return 1;
 }
 
 
@@ -0,0 +1,75 @@
+/*
+ * profile.c
+ *
+ * Sampling profiler based on performance counter overflow interrupts.
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#include <kernel.h>
+#include <assert.h>
+#include <arch.h>
+#include <sched.h>
+#include <task.h>
+#include <part.h>
+#include <profile.h>
+
+#if (PROFILE_SAMPLES & (PROFILE_SAMPLES - 1)) != 0
+#error PROFILE_SAMPLES must be a power of two
+#endif
+
+#ifdef SMP
+#define NUM_PROFILE_BUFS MAX_CPUS
+#else
+#define NUM_PROFILE_BUFS 1
+#endif
+
+/** per-CPU sample buffers, located by the host decoder via this symbol */
+struct profile_buf profile_buf[NUM_PROFILE_BUFS] __aligned(32);
+
+/** initialize the sample buffer and start sampling on the current CPU */
+__init void profile_init(void)
+{
+	struct profile_buf *buf;
+	unsigned int cpu;
+
+	cpu = arch_cpu_id();
+	assert(cpu < NUM_PROFILE_BUFS);
+	buf = &profile_buf[cpu];
+
+	buf->num_samples = PROFILE_SAMPLES;
+	buf->sample_size = sizeof(struct profile_sample);
+	buf->count = 0;
+	buf->period = PROFILE_PERIOD;
+	barrier();
+	buf->magic = PROFILE_MAGIC;
+
+	arch_profile_start(PROFILE_PERIOD);
+}
+
+/** record a sample of the current task in the buffer of the current CPU
+ *
+ * NOTE: called from the counter overflow interrupt, so we're the only writer.
+ */
+void profile_sample(unsigned long pc)
+{
+	struct profile_sample *s;
+	struct profile_buf *buf;
+	struct task *task;
+	unsigned int cpu;
+
+	cpu = arch_cpu_id();
+	assert(cpu < NUM_PROFILE_BUFS);
+	buf = &profile_buf[cpu];
+
+	task = current_task();
+	assert(task != NULL);
+
+	s = &buf->samples[buf->count & (PROFILE_SAMPLES - 1)];
+	s->pc = pc;
+	s->task = task_get_global_id(task);
+	s->part = task->cfg->part_cfg->part_id;
+	s->cpu = cpu;
+	barrier();
+	buf->count++;
+}
@@ -270,17 +270,27 @@ void rpc_cancel(struct task *task)
 	/* removal from RPC send / recv queue is done by caller of this function */
 }
 
-/** abort all queued RPC, called on partition shutdown */
-void rpc_abort(struct task *rpc_task, struct rpc *rpc)
+/** abort queued RPCs, called on partition shutdown
+ *
+ * Aborts at most "max" RPCs and returns the number of aborted RPCs.
+ * If the return value is less than "max", all RPCs are aborted.
+ */
+unsigned int rpc_abort(struct task *rpc_task, struct rpc *rpc, unsigned int max)
 {
+	unsigned int aborted;
 	struct task *task;
 	list_t *node;
 
 	assert(rpc != NULL);
 	assert(rpc_task != NULL);
 
+	aborted = 0;
+
 	/* kick all waiting tasks from the send queue ... */
 	while ((node = list_first(&rpc->sendq)) != NULL) {
+		if (aborted == max) {
+			return aborted;
+		}
 		task = list_entry(node, struct task, waitq);
 		assert(task != NULL);
 		assert(task->rpc_task == rpc_task);
@@ -288,15 +298,22 @@ void rpc_abort(struct task *rpc_task, struct rpc *rpc)
 		rpc_set_reply_and_wake(task, 0, E_OS_STATE);
 		assert(rpc_task->pending_activations > 0);
 		rpc_task->pending_activations--;
+		aborted++;
 	}
 	assert(rpc_task->pending_activations == 0);
 
 	/* ... and from the receive queue */
 	while ((node = list_first(&rpc->recvq)) != NULL) {
+		if (aborted == max) {
+			return aborted;
+		}
 		task = list_entry(node, struct task, waitq);
 		assert(task != NULL);
 		assert(task->rpc_task == rpc_task);
 
 		rpc_set_reply_and_wake(task, 0, E_OS_STATE);
+		aborted++;
 	}
+
+	return aborted;
 }
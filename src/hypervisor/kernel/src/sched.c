@@ -25,13 +25,26 @@
 #include <system_timer.h>
 #include <hm.h>
 #include <rpc.h>
+#include <trace.h>
+#include <counter.h>
+#include <wq.h>
 
 /* forward declarations */
 static __noinline struct arch_reg_frame *sched_switch(struct sched_state *sched, struct task *next);
-static void sched_timeout_expire(time_t now, struct task *task);
+static void sched_timeout_expire(time_t now, struct task *task, struct sched_batch *batch);
 static void tp_switch(struct sched_state *sched);
 static void sched_do_part_state_changes(struct sched_state *sched);
 
+/** common start of the first major frame on all CPUs */
+time_t sched_tp_epoch;
+
+#ifdef SMP
+/** boot barrier: CPUs that reached sched_sync_start() */
+static volatile uint8_t sched_sync_arrived[MAX_CPUS];
+/** boot barrier: set by CPU 0 after sched_tp_epoch is valid */
+static volatile uint8_t sched_sync_done;
+#endif
+
 
 /** initialize scheduling */
 __init void sched_init(void)
@@ -74,6 +87,9 @@ __init void sched_init(void)
 
 		sched->idle_task = task_get_task_cfg(cpu)->task;
 		sched->pending_part_mode_change = NULL;
+		sched->pending_wq_wake = NULL;
+		sched->num_deferred_parts = 0;
+		sched->next_deferred_start = INFINITY;
 
 		for (tp = 0; tp < num_timeparts; tp++) {
 			timepart = &core_cfg[cpu].timeparts[tp];
@@ -94,6 +110,7 @@ __init void sched_init(void)
 		}
 
 		sched->timepart = &core_cfg[cpu].timeparts[0];
+		sched->slack_timepart = NULL;
 
 		/* time partitioning */
 		assert(num_tpschedules > 0);
@@ -181,10 +198,14 @@ __init void sched_start(void)
 	assert(part->operating_mode == PART_OPERATING_MODE_IDLE);
 	part->operating_mode = PART_OPERATING_MODE_NORMAL;
 
-	/* start time partitioning (FIXME: not synchronized to other cores!!!) */
+	/* start time partitioning, re-aligned later in sched_sync_start() */
 	sched->last_tp_switch = board_get_time();
 	sched->next_tp_switch = sched->last_tp_switch + sched->tpwindow->duration;
 
+	/* the idle task's execution time is accounted from here on */
+	sched->last_switch = sched->last_tp_switch;
+	sched->budget_expiry = INFINITY;
+
 	/* setup register context for return into the idle task */
 	arch_reg_frame_assign_idle(sched->regs, (unsigned long) board_idle,
 	                             core_cfg[arch_cpu_id()].idle_stack,
@@ -210,14 +231,10 @@ static inline unsigned int sched_curr_prio(void)
 	return user_prio;
 }
 
-/** insert a task at the tail of the ready queue
- *  - the task must be not on the ready queue before
- *  - if the ready queue changes, necessary scheduling is triggered
- */
-void sched_readyq_insert_tail(struct task *task)
+/** enqueue a task at the tail of the ready queue, without rescheduling */
+static inline __alwaysinline void readyq_enqueue_tail(struct task *task)
 {
 	struct timepart_state *timepart;
-	struct sched_state *sched;
 	unsigned int prio;
 
 	assert(task != NULL);
@@ -238,8 +255,15 @@ void sched_readyq_insert_tail(struct task *task)
 	list_node_init(&task->ready_and_timeoutq);
 	list_add_last(&timepart->readyq[prio], &task->ready_and_timeoutq);
 	readyq_set_bit(timepart, prio);
+}
+
+/** update next_prio and trigger rescheduling after tasks of priority "prio"
+ *  were enqueued into the ready queue of "timepart"
+ */
+static void sched_readyq_update(struct timepart_state *timepart, unsigned int prio)
+{
+	struct sched_state *sched;
 
-	/* update next_prio */
 	if (prio > timepart->next_prio) {
 		timepart->next_prio = prio;
 
@@ -247,19 +271,81 @@ void sched_readyq_insert_tail(struct task *task)
 		if (timepart == sched->timepart) {
 			sched->user_sched_state->next_prio = prio;
 
-			/* higher prio, rescheduing required */
-			if (prio > sched_curr_prio()) {
+			/* higher prio, rescheduing required,
+			 * the window's tasks always preempt slack reclaimers
+			 */
+			if ((prio > sched_curr_prio()) || (sched->slack_timepart != NULL)) {
 				/* let task enter the scheduler on kernel exit */
 #ifdef SMP
 				sched->reschedule |= 1U << arch_cpu_id();
 #else
 				sched->reschedule = 1;
+#endif
+			}
+		} else if ((timepart == sched->slack_timepart) ||
+		           ((sched->current_task == sched->idle_task) && (num_slack_timeparts > 0))) {
+			/* the idle task or a slack reclaimer may give way */
+			if (timepart == sched->slack_timepart) {
+				sched->user_sched_state->next_prio = prio;
+			}
+
+			if (prio > sched_curr_prio()) {
+#ifdef SMP
+				sched->reschedule |= 1U << arch_cpu_id();
+#else
+				sched->reschedule = 1;
 #endif
 			}
 		}
 	}
 }
 
+/** insert a task at the tail of the ready queue
+ *  - the task must be not on the ready queue before
+ *  - if the ready queue changes, necessary scheduling is triggered
+ */
+void sched_readyq_insert_tail(struct task *task)
+{
+	readyq_enqueue_tail(task);
+	sched_readyq_update(task->cfg->timepart, task->task_prio);
+}
+
+/** add a task at the tail of the ready queue as part of a batch
+ *  - the task must be not on the ready queue before
+ *  - scheduling is deferred to sched_readyq_batch_done()
+ */
+void sched_readyq_batch_add(struct sched_batch *batch, struct task *task)
+{
+	struct timepart_state *timepart;
+
+	assert(batch != NULL);
+
+	readyq_enqueue_tail(task);
+
+	timepart = task->cfg->timepart;
+	if (timepart != batch->timepart) {
+		/* tasks of another time partition: flush the previous one */
+		if (batch->timepart != NULL) {
+			sched_readyq_update(batch->timepart, batch->prio);
+		}
+		batch->timepart = timepart;
+		batch->prio = task->task_prio;
+	} else if (task->task_prio > batch->prio) {
+		batch->prio = task->task_prio;
+	}
+}
+
+/** trigger necessary scheduling for all tasks added to a batch */
+void sched_readyq_batch_done(struct sched_batch *batch)
+{
+	assert(batch != NULL);
+
+	if (batch->timepart != NULL) {
+		sched_readyq_update(batch->timepart, batch->prio);
+		batch->timepart = NULL;
+	}
+}
+
 /** insert a task at the head of the ready queue
  *  - only for starting hooks (from SUSPENDED state)!
  *  - the task must be not on the ready queue before
@@ -295,11 +381,10 @@ void sched_readyq_insert_head(struct task *task)
 		timepart->next_prio = prio;
 
 		sched = current_sched_state();
-		if (timepart == sched->timepart) {
+		if ((timepart == sched->timepart) || (timepart == sched->slack_timepart)) {
 			sched->user_sched_state->next_prio = prio;
 
 			/* let task enter the scheduler on kernel exit */
-			assert(timepart == sched->timepart);
 #ifdef SMP
 			sched->reschedule |= 1U << arch_cpu_id();
 #else
@@ -372,6 +457,37 @@ static void sched_readyq_insert_current_tail(struct task *task)
 }
 
 
+/** put tasks parked by the scheduler back at the head of their ready queues
+ *  - the tasks are in ready state, but not on the ready queue
+ *  - the tasks are re-inserted in reverse order to keep their order
+ */
+static void sched_readyq_unpark(list_t *parked)
+{
+	struct timepart_state *timepart;
+	struct task *task;
+	unsigned int prio;
+	list_t *node;
+
+	assert(parked != NULL);
+
+	while ((node = list_remove_last(parked)) != NULL) {
+		task = list_entry(node, struct task, ready_and_timeoutq);
+		assert(TASK_STATE_IS_READY(task->flags_state));
+		prio = task->task_prio;
+		assert(prio < NUM_PRIOS);
+
+		timepart = task->cfg->timepart;
+
+		list_add_first(&timepart->readyq[prio], &task->ready_and_timeoutq);
+		readyq_set_bit(timepart, prio);
+
+		/* update next_prio */
+		if (prio > timepart->next_prio) {
+			timepart->next_prio = prio;
+		}
+	}
+}
+
 /** remove a task from the ready queue
  *  - the task must be in ready state and enqueued on the ready queue
  *  - the task is taken from the ready queue and enters SUSPENDED state
@@ -409,7 +525,7 @@ void sched_readyq_remove(struct task *task)
 			timepart->next_prio = prio;
 
 			sched = current_sched_state();
-			if (timepart == sched->timepart) {
+			if (timepart == current_timepart()) {
 				sched->user_sched_state->next_prio = prio;
 			}
 		}
@@ -515,7 +631,7 @@ void sched_wait(struct task *task, unsigned int new_state, timeout_t timeout)
 
 /** expire the timeout of a waiting task  */
 /* NOTE: task must be waiting on the current CPU's timeout queue */
-static void sched_timeout_expire(time_t now, struct task *task)
+static void sched_timeout_expire(time_t now, struct task *task, struct sched_batch *batch)
 {
 	struct arch_reg_frame *regs;
 	const struct task_cfg *cfg;
@@ -531,7 +647,24 @@ static void sched_timeout_expire(time_t now, struct task *task)
 
 	cfg = task->cfg;
 
-	if (TASK_STATE_IS_WAIT_ACT(task->flags_state)) {
+	if (task->flags_state & TASK_FLAG_THROTTLED) {
+		/* ISR server: continue with a replenished budget */
+		assert(TASK_STATE_IS_WAIT_ACT(task->flags_state));
+		task->flags_state &= ~TASK_FLAG_THROTTLED;
+		task->server_exec_time = task->exec_time;
+		task->server_replenish = task->expiry_time + cfg->period;
+
+		/* a deferred activation is released now, start its deadline */
+		if (task->flags_state & TASK_FLAG_DEFERRED) {
+			task->flags_state &= ~TASK_FLAG_DEFERRED;
+			if (cfg->capacity > 0) {
+				sched_deadline_start(now, task);
+			}
+		}
+	} else if (TASK_STATE_IS_WAIT_ACT(task->flags_state)) {
+		/* the planned release time is the start of the new activation */
+		task->last_activation = task->expiry_time;
+
 		/* start deadline of delayed activated tasks */
 		/* (wait queue not used here) */
 		if (cfg->capacity > 0) {
@@ -553,7 +686,62 @@ static void sched_timeout_expire(time_t now, struct task *task)
 	}
 
 	/* ... and put onto ready queue again */
-	sched_readyq_insert_tail(task);
+	sched_readyq_batch_add(batch, task);
+}
+
+/** ISR server: let the task wait for the next budget replenishment
+ * - the task must not be on the ready queue
+ */
+static void sched_server_throttle(struct task *task)
+{
+	time_t expiry_time;
+
+	assert(task != NULL);
+	assert(task_is_server(task->cfg));
+
+	task->flags_state |= TASK_FLAG_THROTTLED;
+
+	expiry_time = task->server_replenish;
+	task->expiry_time = expiry_time;
+	list_node_init(&task->ready_and_timeoutq);
+	#define ITER list_entry(__ITER__, struct task, ready_and_timeoutq)
+	list_add_sorted(&task->cfg->timepart->timeoutq, &task->ready_and_timeoutq, ITER->expiry_time >= expiry_time);
+	#undef ITER
+}
+
+/** ISR server: check the budget of a new activation
+ *
+ * The budget is replenished lazily: a full budget is available again
+ * one replenishment period after the first activation in a period.
+ * If the budget is exhausted, the activation is deferred to the next
+ * replenishment and the task waits in WAIT_ACT state.
+ *
+ * Returns non-zero if the task can be made ready now.
+ */
+int sched_server_activate(struct task *task)
+{
+	const struct task_cfg *cfg;
+	time_t now;
+
+	assert(task != NULL);
+	cfg = task->cfg;
+	assert(task_is_server(cfg));
+	assert(TASK_STATE_IS_SUSPENDED(task->flags_state));
+
+	now = board_get_time();
+	if (now >= task->server_replenish) {
+		task->server_exec_time = task->exec_time;
+		task->server_replenish = now + cfg->period;
+	}
+
+	if (task->exec_time - task->server_exec_time < (time_t)cfg->budget) {
+		return 1;
+	}
+
+	task->flags_state = TASK_SET_STATE(task->flags_state, TASK_STATE_WAIT_ACT);
+	task->flags_state |= TASK_FLAG_DEFERRED;
+	sched_server_throttle(task);
+	return 0;
 }
 
 /** start the deadline of a task relative to now */
@@ -674,13 +862,78 @@ static struct task *sched_find_next(struct timepart_state *timepart, struct task
 	return next;
 }
 
+/** find a time partition to reclaim the idle time of the current window */
+static struct timepart_state *sched_find_slack(struct sched_state *sched)
+{
+	struct timepart_state *timepart;
+	unsigned int i;
+
+	for (i = 0; i < num_slack_timeparts; i++) {
+		assert(slack_timeparts[i] < num_timeparts);
+		timepart = &core_cfg[arch_cpu_id()].timeparts[slack_timeparts[i]];
+		if ((timepart != sched->timepart) && (timepart->active_coarse != 0)) {
+			return timepart;
+		}
+	}
+
+	return NULL;
+}
+
+/** charge the execution time since the last context switch to the current task */
+static inline void sched_charge(struct sched_state *sched, time_t now)
+{
+	struct task *task;
+	time_t delta;
+
+	task = sched->current_task;
+	assert(now >= sched->last_switch);
+	delta = now - sched->last_switch;
+	sched->last_switch = now;
+
+	task->exec_time += delta;
+	task->activation_exec_time += delta;
+	sched->current_part_cfg->part->exec_time += delta;
+	if (sched->slack_timepart != NULL) {
+		sched->current_part_cfg->part->slack_time += delta;
+	}
+}
+
+/** arm the per-core budget timer for the current task
+ *
+ * NOTE: the budget is checked in kernel_timer(), so overruns are detected
+ * with the resolution of the system timer.
+ */
+static inline void sched_budget_arm(struct sched_state *sched, struct task *task)
+{
+	timeout_t budget;
+	time_t used;
+
+	budget = task->cfg->budget;
+	if (task_is_server(task->cfg)) {
+		/* ISR servers consume their budget across activations */
+		used = task->exec_time - task->server_exec_time;
+	} else {
+		used = task->activation_exec_time;
+	}
+
+	if ((budget > 0) && (used < (time_t)budget)) {
+		sched->budget_expiry = sched->last_switch + budget - used;
+	} else {
+		/* no budget or already reported */
+		sched->budget_expiry = INFINITY;
+	}
+}
+
 /** the scheduler (called from assembler code) */
 /* this routine picks the highest task eligible for scheduling (on this CPU) */
 struct arch_reg_frame *sched_schedule(void)
 {
 	struct sched_state *sched;
+	unsigned int terminated;
+	unsigned int started;
 	struct task *prev;
 	struct task *next;
+	list_t parked;
 #ifdef SMP
 	uint32_t pending_ipis;
 #endif
@@ -718,14 +971,76 @@ struct arch_reg_frame *sched_schedule(void)
 		}
 	}
 
+	/* continue deferred wake-ups */
+	if (sched->pending_wq_wake != NULL) {
+		wq_do_pending_wakes(sched);
+	}
+
 	/* handle pending partition shutdowns */
 	if (sched->pending_part_mode_change != NULL) {
 		sched_do_part_state_changes(sched);
 	}
 
-	/* pick next task */
-	next = sched_find_next(sched->timepart, sched->idle_task);
+	/* charge the current task while the slack state still applies to it */
+	sched_charge(sched, board_get_time());
+	terminated = 0;
+	started = 0;
+	list_head_init(&parked);
+
+	/* pick next task, let low-criticality time partitions reclaim idle time */
+pick_next:
+	/* nothing else to do in the window: start deferred partitions, even if
+	 * a slack time partition could reclaim the idle time. This is checked
+	 * before a task is taken off a ready queue. One partition per kernel
+	 * entry, the next kernel entry continues with the next one.
+	 */
+	if (unlikely(sched->num_deferred_parts != 0) && (started == 0) &&
+	    (sched->timepart->active_coarse == 0)) {
+		if (part_start_deferred(board_get_time())) {
+			started = 1;
+#ifdef SMP
+			sched->reschedule |= 1U << arch_cpu_id();
+#else
+			sched->reschedule = 1;
+#endif
+			sched_do_part_state_changes(sched);
+		}
+	}
+
+	sched->slack_timepart = NULL;
+	if ((sched->timepart->active_coarse == 0) && (num_slack_timeparts > 0)) {
+		sched->slack_timepart = sched_find_slack(sched);
+	}
+	next = sched_find_next(current_timepart(), sched->idle_task);
 	assert(next != NULL);
+
+	/* tasks of partitions still shutting down are terminated on sight
+	 * (idle partitions are in IDLE mode as well)
+	 */
+	if (unlikely(sched->pending_part_mode_change != NULL) &&
+	    (next != sched->idle_task) &&
+	    (next->cfg->part_cfg->part->operating_mode == PART_OPERATING_MODE_IDLE)) {
+		if (terminated < PART_SHUTDOWN_BATCH) {
+			task_terminate_dequeued(next);
+			terminated++;
+		} else {
+			/* preemption point: park the task and keep picking,
+			 * a forced kernel entry continues with the termination
+			 */
+			list_add_last(&parked, &next->ready_and_timeoutq);
+		}
+		goto pick_next;
+	}
+	if (unlikely(!list_is_empty(&parked))) {
+		sched_readyq_unpark(&parked);
+#ifdef SMP
+		sched->reschedule |= 1U << arch_cpu_id();
+#else
+		sched->reschedule = 1;
+#endif
+		board_kernel_reentry();
+	}
+
 	assert(TASK_STATE_IS_READY(next->flags_state));
 	next->flags_state = TASK_SET_STATE(next->flags_state, TASK_STATE_RUNNING);
 
@@ -742,7 +1057,8 @@ struct arch_reg_frame *sched_schedule(void)
 	if (next == prev) {
 		/* no context switch, but scheduler activity: update user_sched_state */
 		sched->user_sched_state->user_prio = next->task_prio;
-		sched->user_sched_state->next_prio = sched->timepart->next_prio;
+		sched->user_sched_state->next_prio = current_timepart()->next_prio;
+		sched_budget_arm(sched, next);
 	} else {
 		return sched_switch(sched, next);
 	}
@@ -760,9 +1076,13 @@ static struct arch_reg_frame *sched_switch(struct sched_state *sched, struct tas
 	assert(next != NULL);
 
 	//printf("* cpu %d needs a switch from %p '%s'\n", arch_cpu_id(), sched->current_task, sched->current_task->cfg->name);
+	trace_event(TRACE_EV_SWITCH, next->cfg->part_cfg->part_id,
+	            task_get_global_id(sched->current_task), task_get_global_id(next));
+	/* NOTE: the caller already charged the outgoing task */
 	arch_task_save(sched->regs, sched->fpu);
 
 	sched->current_task = next;
+	sched_budget_arm(sched, next);
 	next_cfg = next->cfg;
 	sched->regs = next_cfg->regs;
 	sched->fpu = next_cfg->fpu;
@@ -791,7 +1111,10 @@ static struct arch_reg_frame *sched_switch(struct sched_state *sched, struct tas
 	assert(sched->user_sched_state != NULL);
 	sched->user_sched_state->taskid = next_cfg->task_id;
 	sched->user_sched_state->user_prio = next->task_prio;
-	sched->user_sched_state->next_prio = sched->timepart->next_prio;
+	sched->user_sched_state->next_prio = current_timepart()->next_prio;
+	if (next_part_cfg != prev_part_cfg) {
+		counter_publish_time();
+	}
 
 	return sched->regs;
 }
@@ -960,16 +1283,138 @@ void sys_gettime(void)
 	SET_RET64(time);
 }
 
+/** account execution time of the current activation on completion */
+void sched_activation_done(struct task *task)
+{
+	struct sched_state *sched;
+	time_t response_time;
+	time_t now;
+
+	sched = current_sched_state();
+	assert(task == sched->current_task);
+
+	now = board_get_time();
+	sched_charge(sched, now);
+
+	if (task->activation_exec_time > task->max_exec_time) {
+		task->max_exec_time = task->activation_exec_time;
+	}
+	task->activation_exec_time = 0;
+
+	/* NOTE: delayed activations may still be pending in the future */
+	if (now > task->last_activation) {
+		response_time = now - task->last_activation;
+		if (response_time > task->max_response_time) {
+			task->max_response_time = response_time;
+		}
+	}
+}
+
+/** copy execution time statistics of a task to user space */
+static void sched_exec_stats(struct task *task, exec_stats_t *stats)
+{
+	struct sched_state *sched;
+	unsigned int err;
+
+	err = kernel_check_user_addr(stats, sizeof(*stats));
+	if ((err != E_OK) || (((addr_t)stats & (sizeof(time_t) - 1)) != 0)) {
+		SET_RET(E_OS_ILLEGAL_ADDRESS);
+		return;
+	}
+
+	/* bring the statistics of the caller up to date */
+	sched = current_sched_state();
+	sched_charge(sched, board_get_time());
+
+	/* NOTE: tasks on other CPUs are accounted up to their last context switch */
+	stats->exec_time = task->exec_time;
+	stats->max_exec_time = task->max_exec_time;
+	stats->max_response_time = task->max_response_time;
+	stats->part_exec_time = task->cfg->part_cfg->part->exec_time;
+	stats->part_slack_time = task->cfg->part_cfg->part->slack_time;
+
+	SET_RET(E_OK);
+}
+
+/** Get execution time statistics of a task in the caller's partition */
+void sys_task_exec_stats(unsigned int task_id, exec_stats_t *stats)
+{
+	const struct part_cfg *part_cfg;
+
+	part_cfg = current_part_cfg();
+	assert(part_cfg != NULL);
+	if (task_id >= part_cfg->num_tasks) {
+		SET_RET(E_OS_ID);
+		return;
+	}
+
+	sched_exec_stats(&part_cfg->tasks[task_id], stats);
+}
+
+/** Get execution time statistics of a task in any partition (privileged) */
+void sys_part_exec_stats(unsigned int part_id, unsigned int task_id, exec_stats_t *stats)
+{
+	const struct part_cfg *part_cfg;
+	unsigned int part_limit;
+
+	if (!(current_part_cfg()->flags & PART_FLAG_PRIVILEGED)) {
+		SET_RET(E_OS_ACCESS);	/* ERRNO: partition privilege error */
+		return;
+	}
+
+	/* skip idle partitions, these are invisible to the user */
+	assert(num_partitions >= num_cpus);
+	part_limit = num_partitions - num_cpus;
+	if (part_id >= part_limit) {
+		SET_RET(E_OS_ID);
+		return;
+	}
+	part_id += num_cpus;
+
+	part_cfg = part_get_part_cfg(part_id);
+	if (task_id >= part_cfg->num_tasks) {
+		SET_RET(E_OS_ID);
+		return;
+	}
+
+	sched_exec_stats(&part_cfg->tasks[task_id], stats);
+}
+
 /** notify kernel on timer interrupt (passes current time in nanosecond) */
 void kernel_timer(time_t now)
 {
 	struct sched_state *sched;
+	struct sched_batch batch;
 	struct task *task;
 	list_t *node;
 
 	sched = current_sched_state();
 	assert(sched != NULL);
 
+	sched_readyq_batch_init(&batch);
+
+	/* check execution budget of the current task */
+	if (unlikely(sched->budget_expiry <= now)) {
+		sched->budget_expiry = INFINITY;
+		sched_charge(sched, now);
+		task = sched->current_task;
+		if (task_is_server(task->cfg)) {
+			if (now >= task->server_replenish) {
+				/* replenishment period elapsed while running */
+				task->server_exec_time = task->exec_time;
+				task->server_replenish = now + task->cfg->period;
+				sched_budget_arm(sched, task);
+			} else {
+				/* preempt the ISR server until its budget is replenished */
+				sched_server_throttle(task);
+				sched_wait_internal(task, TASK_STATE_WAIT_ACT);
+			}
+		} else {
+			/* notify HM */
+			hm_async_task_error(task->cfg, HM_ERROR_BUDGET_EXCEEDED, 0);
+		}
+	}
+
 	/* switch time partitions */
 	if (sched->next_tp_switch <= now) {
 		tp_switch(sched);
@@ -984,10 +1429,11 @@ next_timeout:
 		assert(task != NULL);
 
 		if (task->expiry_time <= now) {
-			sched_timeout_expire(now, task);
+			sched_timeout_expire(now, task, &batch);
 			goto next_timeout;
 		}
 	}
+	sched_readyq_batch_done(&batch);
 
 	/* check deadlines */
 next_deadline:
@@ -1005,6 +1451,18 @@ next_deadline:
 		}
 	}
 
+	/* deferred partitions become due while the core is idle
+	 * or a slack time partition reclaims the idle time
+	 */
+	if (unlikely(sched->next_deferred_start <= now) &&
+	    ((sched->current_task == sched->idle_task) || (sched->slack_timepart != NULL))) {
+#ifdef SMP
+		sched->reschedule |= 1U << arch_cpu_id();
+#else
+		sched->reschedule = 1;
+#endif
+	}
+
 	/* notify kernel to increment system timer counter */
 	system_timer_increment();
 }
@@ -1020,7 +1478,7 @@ void sys_wait_periodic(void)
 	cfg = task->cfg;
 	assert(cfg != NULL);
 
-	if (cfg->period <= 0) {
+	if ((cfg->period <= 0) || TASK_TYPE_IS_ISR(cfg->cfgflags_type)) {
 		SET_RET(E_OS_RESOURCE);	/* ERRNO: not a periodic task */
 		return;
 	}
@@ -1032,19 +1490,69 @@ void sys_wait_periodic(void)
 		sched_deadline_disable(task);
 	}
 
+	sched_activation_done(task);
+
 	expiry_time = task->last_activation + cfg->period;
 	task->expiry_time = expiry_time;
 
 	/* go to sleep ... */
 	list_node_init(&task->ready_and_timeoutq);
 	#define ITER list_entry(__ITER__, struct task, ready_and_timeoutq)
-	assert(cfg->timepart == current_sched_state()->timepart);
+	assert(cfg->timepart == current_timepart());
 	list_add_sorted(&cfg->timepart->timeoutq, &task->ready_and_timeoutq, ITER->expiry_time >= expiry_time);
 	#undef ITER
 
 	sched_wait_internal(task, TASK_STATE_WAIT_ACT);
 }
 
+/** synchronize the start of time partitioning on all CPUs
+ *
+ * Each CPU calls this once after its boot path is complete. CPU 0 waits for
+ * all other CPUs and then takes a common epoch, from which all CPUs start
+ * their first major frame. As all schedules span the same system period,
+ * major frames stay aligned across schedule changes, which happen at wrap
+ * around only.
+ *
+ * NOTE: this requires a common time base on all CPUs (BSP property).
+ */
+__init void sched_sync_start(void)
+{
+	struct sched_state *sched = current_sched_state();
+#ifdef SMP
+	unsigned int cpu;
+#endif
+
+	assert(sched != NULL);
+
+#ifdef SMP
+	if (arch_cpu_id() == 0) {
+		for (cpu = 1; cpu < num_cpus; cpu++) {
+			while (sched_sync_arrived[cpu] == 0) {
+				arch_yield();
+			}
+		}
+		sched_tp_epoch = board_get_time();
+		barrier();
+		sched_sync_done = 1;
+	} else {
+		sched_sync_arrived[arch_cpu_id()] = 1;
+		while (sched_sync_done == 0) {
+			arch_yield();
+		}
+		barrier();
+	}
+#else
+	sched_tp_epoch = board_get_time();
+#endif
+
+	VVprintf("* cpu %d starts time partitioning at %lld\n", arch_cpu_id(), (long long)sched_tp_epoch);
+
+	/* the idle task ran before, so the epoch can't be earlier */
+	assert(sched_tp_epoch >= sched->last_switch);
+	sched->last_tp_switch = sched_tp_epoch;
+	sched->next_tp_switch = sched_tp_epoch + sched->tpwindow->duration;
+}
+
 /** Change time partition schedule on target CPU */
 void sys_schedule_change(unsigned int cpu_id, unsigned int schedule_id)
 {
@@ -1076,7 +1584,11 @@ void sys_schedule_change(unsigned int cpu_id, unsigned int schedule_id)
 	schedule_change(tpschedule);
 }
 
-/** internal time partition schedule switch routine on current CPU */
+/** internal time partition schedule switch routine on current CPU
+ *
+ * The new schedule becomes active at the next wrap around of the current
+ * one, i.e. at a major frame boundary common to all CPUs.
+ */
 void schedule_change(const struct tpschedule_cfg *next_tpschedule)
 {
 	struct sched_state *sched;
@@ -1124,6 +1636,8 @@ static void tp_switch(struct sched_state *sched)
 	}
 	sched->next_tp_switch = sched->last_tp_switch + win->duration;
 
+	trace_event(TRACE_EV_TP_SWITCH, win->flags, old_timepart->timepart_id, win->timepart);
+
 	/* notify board */
 	board_tp_switch(old_timepart->timepart_id, win->timepart, win->flags);
 
@@ -1152,25 +1666,37 @@ void sched_enqueue_part_state_change(
 #endif
 }
 
-/** handle pending pending partition state changes */
+/** handle pending pending partition state changes
+ *
+ * Handles one partition per kernel entry. If work remains, e.g. a partition
+ * shutdown in progress, the next kernel entry continues (preemption point).
+ */
 static void sched_do_part_state_changes(
 	struct sched_state *sched)
 {
+	struct part **next_p;
 	struct part *part;
 
 	assert(sched != NULL);
 	assert(sched->pending_part_mode_change != NULL);
 
-	/* dequeue partitions for mode change */
 	part = sched->pending_part_mode_change;
-	sched->pending_part_mode_change = NULL;
-
-next_part:
-	part_state_change(part);
-
-	part = part->next_pending_mode_change;
-	if (part != NULL) {
+	if (part_state_change(part)) {
+		/* dequeue partition, others may have been enqueued in front of it */
+		next_p = &sched->pending_part_mode_change;
+		while (*next_p != part) {
+			assert(*next_p != NULL);
+			next_p = &(*next_p)->next_pending_mode_change;
+		}
+		*next_p = part->next_pending_mode_change;
 		part->next_pending_mode_change = NULL;
-		goto next_part;
+	}
+
+	if (sched->pending_part_mode_change != NULL) {
+#ifdef SMP
+		sched->reschedule |= 1U << arch_cpu_id();
+#else
+		sched->reschedule = 1;
+#endif
 	}
 }
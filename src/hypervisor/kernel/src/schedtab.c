@@ -17,6 +17,7 @@
 #include <event.h>
 #include <hv_error.h>
 #include <hm.h>
+#include <bit.h>
 
 __init void schedtab_init_all(void)
 {
@@ -77,6 +78,57 @@ static void schedtab_start(struct schedtab *schedtab, const struct schedtab_cfg
 	schedtab->deviation = 0;
 }
 
+/** apply all actions of an expiry point in a single pass */
+static void schedtab_dispatch(const struct schedtab_dispatch_cfg *dispatch)
+{
+	const struct schedtab_event_cfg *event;
+	struct task * const *tasks;
+	struct sched_batch batch;
+	struct task *task;
+	unsigned int err;
+	unsigned int i;
+
+	assert(dispatch != NULL);
+
+	/* activated tasks and hooks are rescheduled once */
+	sched_readyq_batch_init(&batch);
+
+	tasks = dispatch->tasks;
+	for (i = 0; i < dispatch->num_tasks; i++) {
+		task = tasks[i];
+		err = task_check_activate(task);
+		if (err == E_OK) {
+			task_do_activate_batch(task, &batch);
+		} else {
+			assert((err == E_OS_LIMIT) || (err == E_OS_PROTECTION_ARRIVAL));
+			hm_async_task_error(task->cfg, HM_ERROR_TASK_ACTIVATION_ERROR, err);
+		}
+	}
+
+	tasks += dispatch->num_tasks;
+	for (i = 0; i < dispatch->num_hooks; i++) {
+		task = tasks[i];
+		err = task_check_activate(task);
+		if (err == E_OK) {
+			task_do_activate_batch(task, &batch);
+		} else {
+			assert((err == E_OS_LIMIT) || (err == E_OS_PROTECTION_ARRIVAL));
+			/* no error reported here */
+		}
+	}
+	sched_readyq_batch_done(&batch);
+
+	event = dispatch->events;
+	for (i = 0; i < dispatch->num_events; i++, event++) {
+		err = ev_set(event->task, event->mask);
+		if (unlikely(err != E_OK)) {
+			assert(err == E_OS_STATE);
+			/* report the lowest event bit, as for a single event action */
+			hm_async_task_error(event->task->cfg, HM_ERROR_TASK_STATE_ERROR, __bit_ffs(event->mask));
+		}
+	}
+}
+
 void schedtab_expire(struct alarm *alm, struct schedtab *schedtab)
 {
 	const struct schedtab_action_cfg *action;
@@ -121,8 +173,8 @@ next_action:
 		if (err == E_OK) {
 			task_do_activate(action->u.task);
 		} else {
-			assert(err == E_OS_LIMIT);
-			hm_async_task_error(action->u.task->cfg, HM_ERROR_TASK_ACTIVATION_ERROR, 0);
+			assert((err == E_OS_LIMIT) || (err == E_OS_PROTECTION_ARRIVAL));
+			hm_async_task_error(action->u.task->cfg, HM_ERROR_TASK_ACTIVATION_ERROR, err);
 		}
 		goto next_action;
 
@@ -131,11 +183,15 @@ next_action:
 		if (err == E_OK) {
 			task_do_activate(action->u.task);
 		} else {
-			assert(err == E_OS_LIMIT);
+			assert((err == E_OS_LIMIT) || (err == E_OS_PROTECTION_ARRIVAL));
 			/* no error reported here */
 		}
 		goto next_action;
 
+	case SCHEDTAB_ACTION_DISPATCH:
+		schedtab_dispatch(action->u.dispatch);
+		goto next_action;
+
 	case SCHEDTAB_ACTION_WAIT:
 		wait_time = action->u.time;
 		break;
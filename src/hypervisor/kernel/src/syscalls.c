@@ -15,12 +15,19 @@
 #include <hv_compiler.h>
 #include <hv_error.h>
 #include <board.h>
+#include <syscalls.h>
+#include <task.h>
+#include <event.h>
+#include <counter.h>
+#include <alarm.h>
+#include <wq.h>
 
 
 __tc_fastcall void sys_putchar(const char c);
 __tc_fastcall void sys_ni_syscall(void);
 __tc_fastcall void sys_cpu_id(void);
 __tc_fastcall void sys_null(void);
+__tc_fastcall void sys_multicall(multicall_t *calls, unsigned int num);
 
 
 /** putchar syscall */
@@ -55,3 +62,87 @@ void sys_null(void)
 {
 	/* a real NULL-syscall */
 }
+
+/** dispatch a single entry of a multicall batch
+ *
+ * NOTE: only system calls that never block or switch the calling task
+ * are supported, as the batch continues after each call.
+ */
+static unsigned int multicall_dispatch(unsigned int id, const unsigned long *args)
+{
+	switch (id) {
+	case SYSCALL_TASK_ACTIVATE:
+		sys_task_activate(args[0]);
+		break;
+	case SYSCALL_EV_SET:
+		sys_ev_set(args[0], args[1]);
+		break;
+	case SYSCALL_EV_CLEAR:
+		sys_ev_clear(args[0]);
+		break;
+	case SYSCALL_IPEV_SET:
+		sys_ipev_set(args[0]);
+		break;
+	case SYSCALL_IPEV_GROUP_SET:
+		sys_ipev_group_set(args[0]);
+		break;
+	case SYSCALL_CTR_INCREMENT:
+		sys_ctr_increment(args[0]);
+		break;
+	case SYSCALL_ALARM_SET_REL:
+		sys_alarm_set_rel(args[0], args[1], args[2]);
+		break;
+	case SYSCALL_ALARM_SET_ABS:
+		sys_alarm_set_abs(args[0], args[1], args[2]);
+		break;
+	case SYSCALL_ALARM_CANCEL:
+		sys_alarm_cancel(args[0]);
+		break;
+	case SYSCALL_WQ_WAKE:
+		sys_wq_wake(args[0], args[1]);
+		break;
+	case SYSCALL_ISR_MASK:
+		sys_isr_mask(args[0]);
+		break;
+	case SYSCALL_ISR_UNMASK:
+		sys_isr_unmask(args[0]);
+		break;
+	default:
+		return E_OS_NOFUNC;
+	}
+
+	return arch_reg_frame_get_return(arch_get_sched_state()->regs);
+}
+
+/** execute a batch of system calls */
+void sys_multicall(multicall_t *calls, unsigned int num)
+{
+	unsigned long args[3];
+	unsigned int err;
+	unsigned int id;
+	unsigned int i;
+
+	if ((num == 0) || (num > MULTICALL_MAX)) {
+		SET_RET(E_OS_VALUE);	/* ERRNO: invalid number of entries */
+		return;
+	}
+
+	/* check the whole array once */
+	err = kernel_check_user_addr(calls, num * sizeof(*calls));
+	if ((err != E_OK) || (((addr_t)calls & (sizeof(long) - 1)) != 0)) {
+		SET_RET(E_OS_ILLEGAL_ADDRESS);
+		return;
+	}
+
+	for (i = 0; i < num; i++) {
+		/* copy in before the call, the array is writable by the caller */
+		id = calls[i].id;
+		args[0] = calls[i].args[0];
+		args[1] = calls[i].args[1];
+		args[2] = calls[i].args[2];
+
+		calls[i].ret = multicall_dispatch(id, args);
+	}
+
+	SET_RET(E_OK);
+}
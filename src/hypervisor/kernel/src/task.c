@@ -14,6 +14,9 @@
 #include <hv_error.h>
 #include <board.h>
 #include <rpc.h>
+#include <hm.h>
+#include <event.h>
+#include <isr_state.h>
 
 
 /* forward declarations */
@@ -166,6 +169,10 @@ void task_prepare(struct task *task)
 	/* events are cleared on activation */
 	task->ev_pending = 0;
 
+	/* start execution time accounting of the new activation */
+	task->activation_exec_time = 0;
+	task->last_activation = board_get_time();
+
 	/* set deadline */
 	if (cfg->capacity > 0) {
 #ifndef NDEBUG
@@ -181,6 +188,27 @@ void task_prepare(struct task *task)
 	arch_reg_frame_init_sda(regs, cfg->part_cfg->sda1_base, cfg->part_cfg->sda2_base);
 }
 
+/** check if an activation request arrives before the task's timeframe expired
+ *
+ * NOTE: the arrival time is recorded for accepted activations only.
+ */
+static inline int task_arrival_too_early(struct task *task)
+{
+	const struct task_cfg *cfg;
+
+	cfg = task->cfg;
+	if (cfg->timeframe <= 0) {
+		return 0;
+	}
+
+	/* the first activation is always accepted */
+	if (task->last_arrival == 0) {
+		return 0;
+	}
+
+	return board_get_time() < task->last_arrival + cfg->timeframe;
+}
+
 /** check if a task activation will succeed or fail */
 unsigned int task_check_activate(struct task *task)
 {
@@ -190,6 +218,10 @@ unsigned int task_check_activate(struct task *task)
 	assert(task->cfg->cpu_id == arch_cpu_id());
 	assert(TASK_TYPE_IS_TASK(task->cfg->cfgflags_type) || TASK_TYPE_IS_HOOK(task->cfg->cfgflags_type));
 
+	if (unlikely(task_arrival_too_early(task))) {
+		return E_OS_PROTECTION_ARRIVAL;
+	}
+
 	if (!TASK_STATE_IS_SUSPENDED(task->flags_state)) {
 		/* task is not suspended, check for multiple activation requests */
 		cfg = task->cfg;
@@ -205,13 +237,27 @@ unsigned int task_check_activate(struct task *task)
 
 /** really activate a task or hook */
 void task_do_activate(struct task *task)
+{
+	struct sched_batch batch;
+
+	sched_readyq_batch_init(&batch);
+	task_do_activate_batch(task, &batch);
+	sched_readyq_batch_done(&batch);
+}
+
+/** really activate a task or hook, scheduling deferred to the batch */
+void task_do_activate_batch(struct task *task, struct sched_batch *batch)
 {
 	assert(task != NULL);
 
+	if (task->cfg->timeframe > 0) {
+		task->last_arrival = board_get_time();
+	}
+
 	if (TASK_STATE_IS_SUSPENDED(task->flags_state)) {
 		/* activate */
 		task_prepare(task);
-		sched_readyq_insert_tail(task);
+		sched_readyq_batch_add(batch, task);
 
 		if (task->cfg->capacity > 0) {
 			sched_deadline_start(board_get_time(), task);
@@ -336,7 +382,7 @@ void sys_task_delayed_activate(unsigned int task_id, int sync __unused, timeout_
 
 	/* add to timeout queue */
 	list_node_init(&task->ready_and_timeoutq);
-	assert(task->cfg->timepart == current_sched_state()->timepart);
+	assert(task->cfg->timepart == current_timepart());
 	#define ITER list_entry(__ITER__, struct task, ready_and_timeoutq)
 	list_add_sorted(&cfg->timepart->timeoutq, &task->ready_and_timeoutq, ITER->expiry_time >= expiry_time);
 	#undef ITER
@@ -440,8 +486,26 @@ void kernel_wake_isr_task(const void *arg0)
 	/* mask the associated interrupt source */
 	board_irq_disable(cfg->irq);
 
+	/* inter-arrival time protection: drop the activation, but keep the
+	 * interrupt source masked to prevent an interrupt storm.
+	 * The partition's error hook may unmask the source again.
+	 */
+	if (unlikely(task_arrival_too_early(task))) {
+		hm_async_task_error(cfg, HM_ERROR_TASK_ACTIVATION_ERROR, E_OS_PROTECTION_ARRIVAL);
+		return;
+	}
+	if (cfg->timeframe > 0) {
+		task->last_arrival = board_get_time();
+	}
+
 	/* activate ISR */
 	task_prepare(task);
+	if (task_is_server(cfg) && !sched_server_activate(task)) {
+		/* budget of ISR server exhausted: released on replenishment,
+		 * the deadline starts then
+		 */
+		return;
+	}
 	sched_readyq_insert_tail(task);
 
 	if (cfg->capacity > 0) {
@@ -449,6 +513,58 @@ void kernel_wake_isr_task(const void *arg0)
 	}
 }
 
+/** first-level handler of a user ISR: acknowledge and set an event */
+/* NOTE: this is called from the board layer */
+void kernel_isr_flh(const void *arg0)
+{
+	const struct isr_flh_cfg *cfg = arg0;
+	const struct task_cfg *isr_cfg;
+	struct task *isr_task;
+	unsigned int action;
+	unsigned int err;
+
+	assert(cfg != NULL);
+	assert(cfg->task != NULL);
+	assert(cfg->task->cfg->cpu_id == arch_cpu_id());
+	assert(cfg->event_bit < 32);
+	isr_cfg = cfg->isr_task_cfg;
+	assert(isr_cfg != NULL);
+	isr_task = isr_cfg->task;
+	assert(isr_task != NULL);
+
+	/* inter-arrival time protection of the ISR: same as in
+	 * kernel_wake_isr_task(), mask the interrupt source to prevent an
+	 * interrupt storm. The partition's error hook may unmask it again.
+	 */
+	if (unlikely(task_arrival_too_early(isr_task))) {
+		board_irq_disable(isr_cfg->irq);
+		hm_async_task_error(isr_cfg, HM_ERROR_TASK_ACTIVATION_ERROR, E_OS_PROTECTION_ARRIVAL);
+		return;
+	}
+
+	action = ISR_FLH_EVENT;
+	if (cfg->ack != NULL) {
+		action = cfg->ack(cfg->ack_arg0);
+	}
+
+	if (action != ISR_FLH_ACTIVATE && isr_cfg->timeframe > 0) {
+		/* the full path records the arrival itself */
+		isr_task->last_arrival = board_get_time();
+	}
+
+	if (likely(action == ISR_FLH_EVENT)) {
+		err = ev_set(cfg->task, 1u << cfg->event_bit);
+		if (unlikely(err != E_OK)) {
+			assert(err == E_OS_STATE);
+			hm_async_task_error(cfg->task->cfg, HM_ERROR_TASK_STATE_ERROR, cfg->event_bit);
+		}
+	} else if (action == ISR_FLH_ACTIVATE) {
+		/* the full path masks the interrupt source */
+		kernel_wake_isr_task(cfg->isr_task_cfg);
+	}
+	/* else: ISR_FLH_DONE, nothing to do in user space */
+}
+
 /** Terminate a task: do cleanup and let it enter TASK_STATE_SUSPENDED state
  * - the task may be in any state
  * NOTE: this is called on partition shutdown as well
@@ -510,6 +626,22 @@ void task_terminate(struct task *task, int partition_shutdown)
 	}
 }
 
+/** terminate a ready task the scheduler already removed from the ready queue
+ *  (during partition shutdown, interrupt sources of ISRs stay masked)
+ */
+void task_terminate_dequeued(struct task *task)
+{
+	assert(task != NULL);
+	assert(TASK_STATE_IS_READY(task->flags_state));
+
+	if (task->cfg->capacity > 0) {
+		/* remove from deadline queue */
+		list_del(&task->deadlineq);
+	}
+
+	task->flags_state = TASK_SET_STATE(task->flags_state, TASK_STATE_SUSPENDED);
+}
+
 /** Terminate any other task (except the current one) */
 void sys_task_terminate_other(unsigned int task_id)
 {
@@ -559,6 +691,7 @@ void task_terminate_self(struct task *task)
 		list_del(&task->deadlineq);
 	}
 
+	sched_activation_done(task);
 	sched_suspend(task);
 
 	/* NOTE: activate again if still has pending activations! */
@@ -0,0 +1,74 @@
+/*
+ * trace.c
+ *
+ * Kernel event tracing.
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#include <kernel.h>
+#include <assert.h>
+#include <arch.h>
+#include <sched.h>
+#include <trace.h>
+
+#if (TRACE_EVENTS & (TRACE_EVENTS - 1)) != 0
+#error TRACE_EVENTS must be a power of two
+#endif
+
+#ifdef SMP
+#define NUM_TRACE_BUFS MAX_CPUS
+#else
+#define NUM_TRACE_BUFS 1
+#endif
+
+/** per-CPU trace buffers, located by the host decoder via this symbol */
+struct trace_buf trace_buf[NUM_TRACE_BUFS] __aligned(32);
+
+/** initialize the trace buffer of the current CPU */
+__init void trace_init(void)
+{
+	struct trace_buf *buf;
+	unsigned int cpu;
+
+	cpu = arch_cpu_id();
+	assert(cpu < NUM_TRACE_BUFS);
+	buf = &trace_buf[cpu];
+
+	buf->num_events = TRACE_EVENTS;
+	buf->event_size = sizeof(struct trace_event);
+	buf->count = 0;
+	barrier();
+	buf->magic = TRACE_MAGIC;
+}
+
+/** record an event in the trace buffer of the current CPU
+ *
+ * NOTE: the kernel runs with interrupts disabled, so we're the only writer.
+ */
+void trace_event(unsigned int type, unsigned int arg0, unsigned long arg1, unsigned long arg2)
+{
+	struct trace_event *ev;
+	struct trace_buf *buf;
+	unsigned int cpu;
+
+	cpu = arch_cpu_id();
+	assert(cpu < NUM_TRACE_BUFS);
+	buf = &trace_buf[cpu];
+
+	ev = &buf->events[buf->count & (TRACE_EVENTS - 1)];
+	ev->timestamp = arch_trace_timestamp();
+	ev->type = type;
+	ev->cpu = cpu;
+	ev->arg0 = arg0;
+	ev->arg1 = arg1;
+	ev->arg2 = arg2;
+	barrier();
+	buf->count++;
+}
+
+/** record a syscall entry (called from the assembler syscall path) */
+void trace_syscall(unsigned long syscall_id)
+{
+	trace_event(TRACE_EV_SYSCALL, 0, syscall_id, 0);
+}
@@ -8,6 +8,7 @@
 
 #include <kernel.h>
 #include <assert.h>
+#include <board.h>
 #include <wq.h>
 #include <hv_error.h>
 #include <task_state.h>
@@ -36,15 +37,62 @@ __init void wq_init_all(void)
 			assert(wq != NULL);
 
 			list_head_init(&wq->waitq);
+			list_node_init(&wq->wake_mark);
 
 			/* state initialized to zero at boot */
 			assert(wq->state == WQ_STATE_CLOSED);
 
 			wq->cpu_id = part_cfg->cpu_id;
+			wq->wake_remaining = 0;
+			wq->next_pending_wake = NULL;
 		}
 	}
 }
 
+/** remove the marker of a deferred wake-up from the wait queue
+ *
+ * With priority discipline, the tasks behind the marker started waiting
+ * during the deferred wake-up. They are merged into the remaining waiters.
+ */
+static void wq_remove_mark(
+	struct wq *wq)
+{
+	struct task *task;
+	list_t *node;
+	list_t *next;
+	list_t *prev;
+	list_t *pos;
+
+	assert(wq != NULL);
+
+	node = wq->wake_mark.next;
+	list_del(&wq->wake_mark);
+
+	if (wq->discipline != WQ_DISCIPLINE_PRIO) {
+		return;
+	}
+
+	/* both parts are sorted, equal priorities keep their FIFO order */
+	pos = wq->waitq.next;
+	while (node != &wq->waitq) {
+		task = list_entry(node, struct task, waitq);
+		while ((pos != node) &&
+		       (list_entry(pos, struct task, waitq)->wait_prio >= task->wait_prio)) {
+			pos = pos->next;
+		}
+		if (pos == node) {
+			/* the rest is in order */
+			break;
+		}
+
+		next = node->next;
+		list_del(node);
+		prev = pos->prev;
+		__list_add(prev, node, pos);
+		node = next;
+	}
+}
+
 /** close a wait queue -- called on partition shutdown/reboot
  *
  * Called after all the partition's tasks have been terminated,
@@ -54,6 +102,12 @@ void wq_close(struct wq *wq)
 {
 	assert(wq != NULL);
 
+	/* a pending wait queue is dequeued on the next kernel entry */
+	if (wq->wake_remaining != 0) {
+		wq_remove_mark(wq);
+		wq->wake_remaining = 0;
+	}
+
 	assert(list_is_empty(&wq->waitq));
 	wq->state = WQ_STATE_CLOSED;
 }
@@ -109,6 +163,41 @@ void sys_wq_set_discipline(
 	SET_RET(E_OK);
 }
 
+/** insert a task into a wait queue with priority discipline
+ *
+ * Tasks that start waiting during a deferred wake-up are enqueued behind
+ * the marker, so they do not overtake the waiters of the wake-up.
+ */
+static void wq_insert_prio(
+	struct wq *wq,
+	struct task *task)
+{
+	unsigned int prio;
+	list_t *prev;
+	list_t *pos;
+
+	assert(wq != NULL);
+	assert(task != NULL);
+
+	prio = task->wait_prio;
+	if (wq->wake_remaining == 0) {
+		#define ITER list_entry(__ITER__, struct task, waitq)
+		list_add_sorted(&wq->waitq, &task->waitq, ITER->wait_prio < prio);
+		#undef ITER
+		return;
+	}
+
+	pos = wq->wake_mark.next;
+	while (pos != &wq->waitq) {
+		if (list_entry(pos, struct task, waitq)->wait_prio < prio) {
+			break;
+		}
+		pos = pos->next;
+	}
+	prev = pos->prev;
+	__list_add(prev, &task->waitq, pos);
+}
+
 /** Wait on a wait queue */
 void __sys_wq_wait(
 	unsigned int wq_id,
@@ -162,9 +251,7 @@ void __sys_wq_wait(
 	list_node_init(&task->waitq);
 
 	if (wq->discipline == WQ_DISCIPLINE_PRIO) {
-		#define ITER list_entry(__ITER__, struct task, waitq)
-		list_add_sorted(&wq->waitq, &task->waitq, ITER->wait_prio < prio);
-		#undef ITER
+		wq_insert_prio(wq, task);
 	} else {
 		list_add_last(&wq->waitq, &task->waitq);
 	}
@@ -202,19 +289,21 @@ void sys_sleep(timeout_t timeout)
 	sched_wait(task, TASK_STATE_WAIT_WQ, timeout);
 }
 
-void wq_wake(
+/** wake up to "count" waiters now */
+static void wq_wake_now(
 	struct wq *wq,
 	unsigned int count)
 {
+	struct sched_batch batch;
+	unsigned int woken;
 	struct task *task;
 	list_t *node;
 
 	assert(wq != NULL);
 
-	/* wake "count" waiters */
-	while (count > 0) {
-		count--;
-
+	/* wake "count" waiters, reschedule once */
+	sched_readyq_batch_init(&batch);
+	for (woken = 0; woken < count; woken++) {
 		/* get first task from list */
 		node = list_remove_first(&wq->waitq);
 		if (node == NULL) {
@@ -227,7 +316,162 @@ void wq_wake(
 		/* wake up task: remove from timeout queue */
 		list_del(&task->ready_and_timeoutq);
 
-		sched_readyq_insert_tail(task);
+		sched_readyq_batch_add(&batch, task);
+	}
+	sched_readyq_batch_done(&batch);
+}
+
+/** wake up to WQ_WAKE_BATCH waiters of a deferred wake-up
+ *
+ * The waiters in front of the marker are woken until the marker is reached
+ * or no wake-ups remain. Then the marker is removed again.
+ */
+static void wq_wake_deferred(
+	struct wq *wq)
+{
+	struct sched_batch batch;
+	struct task *task;
+	unsigned int i;
+	list_t *node;
+
+	assert(wq != NULL);
+	assert(wq->wake_remaining != 0);
+
+	sched_readyq_batch_init(&batch);
+	for (i = 0; i < WQ_WAKE_BATCH; i++) {
+		node = __list_first(&wq->waitq);
+		if (node == &wq->wake_mark) {
+			break;
+		}
+		list_del(node);
+		task = list_entry(node, struct task, waitq);
+		assert(task != NULL);
+		assert(TASK_STATE_IS_WAIT_WQ(task->flags_state));
+
+		/* wake up task: remove from timeout queue */
+		list_del(&task->ready_and_timeoutq);
+
+		sched_readyq_batch_add(&batch, task);
+
+		wq->wake_remaining--;
+		if (wq->wake_remaining == 0) {
+			break;
+		}
+	}
+	sched_readyq_batch_done(&batch);
+
+	if (__list_first(&wq->waitq) == &wq->wake_mark) {
+		/* all waiters in front of the marker are woken */
+		wq->wake_remaining = 0;
+	}
+	if (wq->wake_remaining == 0) {
+		wq_remove_mark(wq);
+	}
+}
+
+/** wake up to "count" tasks on wait queue
+ *
+ * Up to WQ_WAKE_BATCH waiters are woken at once. For more, a marker is put
+ * at the end of the wait queue, and the waiters in front of the marker are
+ * woken in batches of WQ_WAKE_BATCH on the next kernel entries (preemption
+ * points), see wq_do_pending_wakes(). A software interrupt forces these
+ * kernel entries. Tasks that start waiting later are enqueued behind the
+ * marker and are not woken, unless a further wake-up extends the pending one.
+ *
+ * NOTE: waiters that time out before their deferred wake-up leave the wait
+ * queue as usual, so the wake-up stops at the marker.
+ */
+void wq_wake(
+	struct wq *wq,
+	unsigned int count)
+{
+	struct sched_state *sched;
+
+	assert(wq != NULL);
+	assert(wq->cpu_id == arch_cpu_id());
+
+	if (count > NUM_WAITERS) {
+		count = NUM_WAITERS;
+	}
+
+	if (wq->wake_remaining == 0) {
+		if (count <= WQ_WAKE_BATCH) {
+			wq_wake_now(wq, count);
+			return;
+		}
+	} else {
+		if (count == 0) {
+			return;
+		}
+
+		/* extend the pending wake-up to the current waiters */
+		count += wq->wake_remaining;
+		if (count > NUM_WAITERS) {
+			count = NUM_WAITERS;
+		}
+		wq_remove_mark(wq);
+	}
+
+	list_add_last(&wq->waitq, &wq->wake_mark);
+	wq->wake_remaining = count;
+
+	wq_wake_deferred(wq);
+	if (wq->wake_remaining == 0) {
+		return;
+	}
+
+	sched = current_sched_state();
+	if (wq->next_pending_wake == NULL) {
+		/* enqueue, the last wait queue in the list points to itself */
+		if (sched->pending_wq_wake != NULL) {
+			wq->next_pending_wake = sched->pending_wq_wake;
+		} else {
+			wq->next_pending_wake = wq;
+		}
+		sched->pending_wq_wake = wq;
+	}
+
+#ifdef SMP
+	sched->reschedule |= 1U << arch_cpu_id();
+#else
+	sched->reschedule = 1;
+#endif
+	board_kernel_reentry();
+}
+
+/** continue deferred wake-ups, one batch per kernel entry */
+void wq_do_pending_wakes(
+	struct sched_state *sched)
+{
+	struct wq *wq;
+
+	assert(sched != NULL);
+	wq = sched->pending_wq_wake;
+	assert(wq != NULL);
+	assert(wq->next_pending_wake != NULL);
+
+	/* NOTE: a wait queue closed in the meantime has no wake-ups left */
+	if (wq->wake_remaining != 0) {
+		wq_wake_deferred(wq);
+	}
+
+	if (wq->wake_remaining == 0) {
+		/* dequeue */
+		if (wq->next_pending_wake == wq) {
+			sched->pending_wq_wake = NULL;
+		} else {
+			sched->pending_wq_wake = wq->next_pending_wake;
+		}
+		wq->next_pending_wake = NULL;
+	}
+
+	if (sched->pending_wq_wake != NULL) {
+#ifdef SMP
+		sched->reschedule |= 1U << arch_cpu_id();
+#else
+		sched->reschedule = 1;
+#endif
+		board_kernel_reentry();
 	}
 }
 
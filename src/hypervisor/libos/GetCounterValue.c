@@ -18,7 +18,7 @@ StatusType GetCounterValue(CounterType CounterID, TickRefType ValueRef)
 	record.arg1 = CounterID;
 	record.arg2 = (unsigned long)ValueRef;
 
-	err = sys_ctr_get(CounterID, (ctrtick_t *)ValueRef);
+	err = sys_fast_ctr_get(CounterID, (ctrtick_t *)ValueRef);
 	if (unlikely(err != E_OK)) {
 		return _OsRaiseError(err, &record, OSServiceId_GetCounterValue);
 	}
@@ -19,7 +19,7 @@ StatusType GetElapsedValue(CounterType CounterID, TickRefType ValueRef, TickRefT
 	record.arg2 = (unsigned long)ValueRef;
 	record.arg3 = (unsigned long)ElapsedValueRef;
 
-	err = sys_ctr_elapsed(CounterID, *(ctrtick_t *)ElapsedValueRef, (ctrtick_t *)ValueRef, (ctrtick_t *)ElapsedValueRef);
+	err = sys_fast_ctr_elapsed(CounterID, *(ctrtick_t *)ElapsedValueRef, (ctrtick_t *)ValueRef, (ctrtick_t *)ElapsedValueRef);
 	if (unlikely(err != E_OK)) {
 		return _OsRaiseError(err, &record, OSServiceId_GetElapsedValue);
 	}
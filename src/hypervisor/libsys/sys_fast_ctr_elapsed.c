@@ -0,0 +1,42 @@
+/*
+ * sys_fast_ctr_elapsed.c
+ *
+ * Syscall library fast time and counter access.
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#include <hv.h>
+#include <hv_compiler.h>
+#include "sys_private.h"
+
+unsigned int sys_fast_ctr_elapsed(unsigned int ctr_id, ctrtick_t previous, ctrtick_t *value, ctrtick_t *elapsed)
+{
+	const user_time_state_t *ts = &__sys_sched_state.time;
+	ctrtick_t maxallowedvalue;
+	ctrtick_t current;
+	uint32_t valid;
+	uint32_t seq;
+
+	if (unlikely(ctr_id >= USER_TIME_NUM_CTRS)) {
+		return sys_ctr_elapsed(ctr_id, previous, value, elapsed);
+	}
+
+	do {
+		seq = ts->seq;
+		barrier();
+		valid = ts->ctr_valid;
+		current = ts->ctr[ctr_id].value;
+		maxallowedvalue = ts->ctr[ctr_id].maxallowedvalue;
+		barrier();
+	} while (unlikely((seq & 1) || (seq != ts->seq)));
+
+	/* let the kernel handle unpublished counters and report errors */
+	if (unlikely(((valid & (1u << ctr_id)) == 0) || (previous >= maxallowedvalue))) {
+		return sys_ctr_elapsed(ctr_id, previous, value, elapsed);
+	}
+
+	*value = current;
+	*elapsed = current - previous;
+	return E_OK;
+}
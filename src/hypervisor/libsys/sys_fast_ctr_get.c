@@ -0,0 +1,38 @@
+/*
+ * sys_fast_ctr_get.c
+ *
+ * Syscall library fast time and counter access.
+ *
+ * agent, 2026-10-18: initial
+ */
+
+#include <hv.h>
+#include <hv_compiler.h>
+#include "sys_private.h"
+
+unsigned int sys_fast_ctr_get(unsigned int ctr_id, ctrtick_t *value)
+{
+	const user_time_state_t *ts = &__sys_sched_state.time;
+	ctrtick_t current;
+	uint32_t valid;
+	uint32_t seq;
+
+	if (unlikely(ctr_id >= USER_TIME_NUM_CTRS)) {
+		return sys_ctr_get(ctr_id, value);
+	}
+
+	do {
+		seq = ts->seq;
+		barrier();
+		valid = ts->ctr_valid;
+		current = ts->ctr[ctr_id].value;
+		barrier();
+	} while (unlikely((seq & 1) || (seq != ts->seq)));
+
+	if (unlikely((valid & (1u << ctr_id)) == 0)) {
+		return sys_ctr_get(ctr_id, value);
+	}
+
+	*value = current;
+	return E_OK;
+}
@@ -13,6 +13,7 @@ OBJCOPY = $(CROSS)objcopy
 DEPCC = $(CROSS)gcc -M
 CPP = $(CROSS)gcc -E
 NM = $(CROSS)nm
+SIZE = $(CROSS)size
 STRIP = $(CROSS)strip
 AR = $(CROSS)ar
 
@@ -31,13 +31,19 @@ ifneq ("$(FOOBAR_MPU_CFG)", "")
 MPU_CFG = $(FOOBAR_MPU_CFG)
 endif
 
-# Default rules for DEBUG and SMP
+# Default rules for DEBUG, SMP, TRACE and PROFILE
 ifeq ("$(DEBUG)", "")
 DEBUG = yes
 endif
 ifeq ("$(SMP)", "")
 SMP = yes
 endif
+ifeq ("$(TRACE)", "")
+TRACE = no
+endif
+ifeq ("$(PROFILE)", "")
+PROFILE = no
+endif
 
 # Catch errors
 ifeq ("$(FOOBAR_ARCH)", "")
@@ -0,0 +1,213 @@
+#!/usr/bin/perl -w
+#
+# ab_cache.pl - skip configuration generator steps with unchanged inputs
+#
+# Wraps a generator command and records an MD5 digest of the command line,
+# the contents of all inputs and the contents of all outputs in a stamp file.
+# If the digest matches on the next call, the command is not executed.
+#
+# If the command runs and an output ends up with the same content as before,
+# the output's original timestamp is restored. Make rules depending on the
+# output then don't fire, e.g. an unchanged app.ld.h doesn't cause a relink.
+#
+# Usage: ab_cache.pl -s <stamp> [-k <key>] [-i <input> ...] [-o <output> ...] -- <command ...>
+#
+# agent, 2026-10-18: initial
+
+
+use strict;
+use warnings "all";
+use Digest::MD5;
+
+# tool version ID
+my $VERSION = "ab_cache.pl 2026-10-18";
+
+# global variables
+my $verbose = 0;
+
+
+################################################################################
+
+# Return MD5 digest of a file's content, or undef if the file doesn't exist
+sub filedigest
+{
+	my $filename = shift;
+	my $FILE;
+
+	if (!-f $filename) {
+		return undef;
+	}
+
+	open($FILE, "<$filename") or die "Couldn't open $filename file for reading, $!\n";
+	binmode($FILE);
+	my $digest = Digest::MD5->new->addfile($FILE)->hexdigest;
+	close($FILE) or die "Couldn't close $filename, $!\n";
+
+	return $digest;
+}
+
+# Return digest over the command line and the inputs and outputs
+sub stepdigest
+{
+	my ($key, $cmd, $inputs, $outputs) = @_;
+	my $ctx = Digest::MD5->new;
+
+	$ctx->add($VERSION, "\0", $key, "\0");
+	$ctx->add(join("\0", @$cmd), "\0");
+	for my $f (@$inputs, "--", @$outputs) {
+		my $d = filedigest($f);
+		$ctx->add($f, "\0", defined $d ? $d : "missing", "\0");
+	}
+
+	return $ctx->hexdigest;
+}
+
+# Read the digest from a stamp file
+sub readstamp
+{
+	my $filename = shift;
+	my $FILE;
+
+	open($FILE, "<$filename") or return "";
+	my $line = <$FILE>;
+	close($FILE);
+
+	if (!defined $line) {
+		return "";
+	}
+	chomp $line;
+	return $line;
+}
+
+################################################################################
+
+sub usage
+{
+	my $ret = shift;
+	if (!defined $ret) {
+		$ret = 1;
+	}
+
+	print "usage:\n";
+	print "  ab_cache.pl [-h|--help] [--version]\n";
+	print "              [-v]\n";
+	print "              -s <stamp> [-k <key>]\n";
+	print "              [-i <input> ...] [-o <output> ...]\n";
+	print "              -- <command ...>\n";
+	print "\n";
+	print "options:\n";
+	print "  -h|--help       print this help text and exit\n";
+	print "  --version       print version information and exit\n";
+	print "  -v              verbosity level, increases for each -v\n";
+	print "  -s <stamp>      stamp file keeping the digest of the last run\n";
+	print "  -k <key>        extra string for the digest, e.g. build flags\n";
+	print "  -i <input>      file read by the command\n";
+	print "  -o <output>     file written by the command\n";
+	print "  <command ...>   generator command to execute\n";
+
+	exit $ret;
+}
+
+################################################################################
+
+my $stampfile;
+my $key = "";
+my @inputs;
+my @outputs;
+my @cmd;
+
+while (defined $ARGV[0]) {
+	if ($ARGV[0] eq '--help') {
+		usage(0);
+	} elsif ($ARGV[0] eq '-h') {
+		usage(0);
+	} elsif ($ARGV[0] eq '--version') {
+		print "version: ", $VERSION, "\n";
+		exit 0;
+	} elsif ($ARGV[0] eq '-v') {
+		shift;
+		$verbose++;
+	} elsif ($ARGV[0] eq '-s') {
+		shift;
+		$stampfile = shift;
+	} elsif ($ARGV[0] eq '-k') {
+		shift;
+		$key .= shift;
+	} elsif ($ARGV[0] eq '-i') {
+		shift;
+		push(@inputs, shift);
+	} elsif ($ARGV[0] eq '-o') {
+		shift;
+		push(@outputs, shift);
+	} elsif ($ARGV[0] eq '--') {
+		shift;
+		@cmd = @ARGV;
+		last;
+	} else {
+		die "error: invalid argument '", $ARGV[0], "'\n";
+	}
+}
+
+if (!defined $stampfile) {
+	die "error: no stamp file specified\n";
+}
+
+if (@cmd == 0) {
+	die "error: no command specified\n";
+}
+
+my $digest = stepdigest($key, \@cmd, \@inputs, \@outputs);
+if ($digest eq readstamp($stampfile)) {
+	my $missing = grep { !-f $_ } @outputs;
+	if ($missing == 0) {
+		if ($verbose) {
+			print "  CACHE $stampfile\n";
+		}
+		exit 0;
+	}
+}
+
+# remember old output digests and timestamps
+my %olddigest;
+my %oldtime;
+for my $f (@outputs) {
+	my $d = filedigest($f);
+	if (defined $d) {
+		my @st = stat($f);
+		$olddigest{$f} = $d;
+		$oldtime{$f} = [$st[8], $st[9]];
+	}
+}
+
+# invalidate the stamp while the command runs
+unlink($stampfile);
+
+if ($verbose) {
+	print "  RUN   ", join(" ", @cmd), "\n";
+}
+if (system(@cmd) != 0) {
+	die "error: command '", $cmd[0], "' failed\n";
+}
+
+# keep timestamps of outputs that didn't change
+for my $f (@outputs) {
+	if (!-f $f) {
+		die "error: command '", $cmd[0], "' didn't create output '$f'\n";
+	}
+	if (defined $olddigest{$f} && filedigest($f) eq $olddigest{$f}) {
+		if ($verbose) {
+			print "  SAME  $f\n";
+		}
+		utime($oldtime{$f}[0], $oldtime{$f}[1], $f);
+	}
+}
+
+# the outputs are part of the digest, so compute it again
+$digest = stepdigest($key, \@cmd, \@inputs, \@outputs);
+
+{
+	my $FILE;
+	open $FILE, ">$stampfile" or die "Couldn't open $stampfile file for writing, $!\n";
+	print $FILE $digest, "\n";
+	close($FILE) or die "Couldn't close $stampfile, $!\n";
+}
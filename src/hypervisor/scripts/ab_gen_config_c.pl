@@ -231,10 +231,11 @@ sub gen_config
 					               'sched_table', 'expiry', 'action_task', 'action_hook',
 					               'action_event', 'action_counter', 'action_invoke',
 					               'defaultisr', 'wait_queue', 'shm', 'shm_access',
-					               'schedule', 'window', 'range',
+					               'schedule', 'window', 'range', 'data',
 					               'hm_table', 'error',
 					               'rpc', 'invokable',
-					               'kldd', 'ipev', 'alarm', 'counter', 'counter_access'],
+					               'kldd', 'ipev', 'ipev_group', 'alarm', 'counter', 'counter_access',
+					               'first_level'],
 					) or die "opening and parsing failed!\n";
 
 	my $sys = $all->{system};
@@ -255,6 +256,19 @@ sub gen_config
 	}
 	my $num_timeparts = number $sys->{timeparts};
 
+	# low-criticality time partitions reclaiming idle time, in order
+	my @slack_timeparts = ();
+	if (defined $sys->{slack}) {
+		for my $tp (split(/[\s,]+/, $sys->{slack})) {
+			next if ($tp eq "");
+			$tp = number $tp;
+			if ($tp >= $num_timeparts) {
+				die "error: slack time partition ", $tp, " out of bounds\n";
+			}
+			push(@slack_timeparts, $tp);
+		}
+	}
+
  	my $num_isrs = number $target->{isrs};
 
 	my $kern_contexts = 0;	# Register contexts for the kernel
@@ -324,6 +338,11 @@ sub gen_config
 	my %sta_arg2s;
 	my %sta_arg3s;
 	my %sta_arg4s;
+	my %sta_arg5s;
+	my $num_dispatches = 0;
+	my @dispatches;
+	my @dispatch_tasks;
+	my @dispatch_events;
 	my %core_reg_frames;
 	my %core_fpu_frames;
 	my %core_ctxt_frames;
@@ -392,6 +411,7 @@ sub gen_config
 	print $CFGFILE "extern const struct shm_cfg shm_cfg[];\n";
 	print $CFGFILE "extern const struct kldd_cfg kldd_cfg[];\n";
 	print $CFGFILE "extern const struct ipev_cfg ipev_cfg[];\n";
+	print $CFGFILE "extern const struct ipev_group_cfg ipev_group_cfg[];\n";
 	print $CFGFILE "extern const struct arch_mpu_task_cfg mpu_task_cfg[];\n";
 	print $CFGFILE "extern const struct arch_mpu_part_cfg mpu_part_cfg[];\n";
 	print $CFGFILE "extern const struct tpwindow_cfg tpwindow_cfg[];\n";
@@ -401,10 +421,17 @@ sub gen_config
 	print $CFGFILE "/* scheduler configuration */\n";
 	print $CFGFILE "const uint8_t num_cpus __section_cfg = ", $num_cpus, ";\n";
 	print $CFGFILE "const uint8_t num_timeparts __section_cfg = ", $num_timeparts, ";\n";
+	print $CFGFILE "const uint8_t num_slack_timeparts __section_cfg = ", scalar @slack_timeparts, ";\n";
+	if (scalar @slack_timeparts > 0) {
+		print $CFGFILE "const uint8_t slack_timeparts[", scalar @slack_timeparts, "] __section_cfg = { ", join(", ", @slack_timeparts), " };\n";
+	} else {
+		# NOTE: some compilers reject zero-length arrays
+		print $CFGFILE "const uint8_t slack_timeparts[1] __section_cfg = { 0 };\t/* dummy */\n";
+	}
 	for (my $cpu = 0; $cpu < $num_cpus; $cpu++) {
 		print $CFGFILE "struct sched_state sched_state_core_", $cpu, " __section_sched_state_core(", $cpu, ");\n";
-		print $CFGFILE "struct timepart_state timepart_states_core_", $cpu, "[", $num_cpus * $num_timeparts ,"] __section_bss_core(", $cpu, ");\n";
-		print $CFGFILE "struct core_state core_state_core_", $cpu, " __section_bss_core(", $cpu, ");\n";
+		print $CFGFILE "struct timepart_state timepart_states_core_", $cpu, "[", $num_cpus * $num_timeparts ,"] __section_shared_core(", $cpu, ");\n";
+		print $CFGFILE "struct core_state core_state_core_", $cpu, " __section_shared_core(", $cpu, ");\n";
 	}
 
 	# kernel stacks
@@ -472,6 +499,8 @@ sub gen_config
 	my $next_kldd = 0;
 	my $num_ipevs = 0;
 	my $next_ipev = 0;
+	my $num_ipev_groups = 0;
+	my $next_ipev_group = 0;
 	my $num_counters = 0;
 	if ($sys->{counter}) {
 		$num_counters += @{$sys->{counter}};
@@ -489,6 +518,7 @@ sub gen_config
 	my $num_rpcs = 0;
 	my $next_rpc = 0;
 	my %known_shms;
+	my %known_shm_writable;
 
 	# known SHMs
 	my $num_shms = 0;
@@ -497,6 +527,7 @@ sub gen_config
 			die "SHM '" . $shm->{name} . "' already exists\n";
 		}
 		$known_shms{$shm->{name}} = $num_shms;
+		$known_shm_writable{$shm->{name}} = (uc $shm->{type} eq "RAM") ? 1 : 0;
 		$num_shms++;
 	}
 
@@ -573,7 +604,7 @@ sub gen_config
 
 	# dynamic partition data
 	for (my $cpu = 0; $cpu < $num_cpus; $cpu++) {
-		print $CFGFILE "struct part part_dyn_idle_", $cpu, " __section_bss_core(", $cpu, ");\n";
+		print $CFGFILE "struct part part_dyn_idle_", $cpu, " __section_shared_core(", $cpu, ");\n";
 	}
 
 	my $part_id = 0;
@@ -582,7 +613,7 @@ sub gen_config
 		if (!defined $cpu) {
 			$cpu = 0;
 		}
-		print $CFGFILE "struct part part_dyn_part_", $part_id, " __section_bss_core(", $cpu, ");\n";
+		print $CFGFILE "struct part part_dyn_part_", $part_id, " __section_shared_core(", $cpu, ");\n";
 		$part_id++;
 	}
 
@@ -697,6 +728,17 @@ sub gen_config
 
 			}
 			print $CFGFILE "\t\t},\n";
+
+			# .data load image, unpacked by the kernel if compressed
+			if (defined $layout->{data}) {
+				my $data = $layout->{data}[0];
+				my $rom_sym = sym_eval(\%symhash_part, $data->{rom});
+				my $start_sym = sym_eval(\%symhash_part, $data->{start});
+				my $end_sym = sym_eval(\%symhash_part, $data->{end});
+				print $CFGFILE "\t\t.data_rom = ", hexify($rom_sym), ", /* ", $data->{rom}, " */\n";
+				print $CFGFILE "\t\t.data_ram = ", hexify($start_sym), ", /* ", $data->{start}, " */\n";
+				print $CFGFILE "\t\t.data_size = ", $end_sym - $start_sym, ",\n";
+			}
 		}
 
 		# ARINC attributes
@@ -710,6 +752,10 @@ sub gen_config
 			$duration = $part->{duration};
 		}
 		print $CFGFILE "\t\t.duration = ", $duration, ",\n";
+		# earliest start of a deferred partition, see PART_FLAG_DEFERRED_START
+		if (defined $part->{start_delay}) {
+			print $CFGFILE "\t\t.start_delay = ", $part->{start_delay}, ",\n";
+		}
 
 		# magic symbols
 		print $CFGFILE "\t\t.user_sched_state = (user_sched_state_t *)", hexify($user_sched_state), ", /* ", $user_sched_state_name, " */\n";
@@ -752,6 +798,14 @@ sub gen_config
 		print $CFGFILE "\t\t.num_ipevs = ", $num_ipevs - $next_ipev, ",\n";
 		$next_ipev = $num_ipevs;
 
+		# partition's IPEV groups
+		print $CFGFILE "\t\t.ipev_groups = &ipev_group_cfg[", $next_ipev_group, "],\n";
+		if (defined $part->{ipev_group}) {
+			$num_ipev_groups += @{$part->{ipev_group}};
+		}
+		print $CFGFILE "\t\t.num_ipev_groups = ", $num_ipev_groups - $next_ipev_group, ",\n";
+		$next_ipev_group = $num_ipev_groups;
+
 		# partition's counter accesses
 		print $CFGFILE "\t\t.ctr_accs = &counter_access[", $next_ctr_acc, "],\n";
 		if (defined $part->{counter_access}) {
@@ -933,6 +987,8 @@ sub gen_config
 			my $max_activations = 1;
 			my $period = -1;	# default: infinite time (aperiodic process)
 			my $capacity = -1;	# default: infinite time
+			my $budget = 0;		# default: no execution budget
+			my $timeframe = 0;	# default: no inter-arrival time protection
 
 			my $blocking = 0;
 			if (defined $task->{blocking} && $task->{blocking} eq "yes") {
@@ -953,6 +1009,12 @@ sub gen_config
 			if (defined $task->{capacity}) {
 				$capacity = $task->{capacity};
 			}
+			if (defined $task->{budget}) {
+				$budget = $task->{budget};
+			}
+			if (defined $task->{timeframe}) {
+				$timeframe = $task->{timeframe};
+			}
 
 			print $CFGFILE "\t/* #", $task_array_index, ": ", ($blocking?"blocking ":""), "task '", $task->{name}, "' in partition '", $part->{name}, "' */ {\n";
 			print $CFGFILE "\t\t.task = &task_dyn_part_", $part_cnt, "[", $task_cnt, "],\n";
@@ -968,6 +1030,11 @@ sub gen_config
 			print $CFGFILE "\t\t.capacity = ", $capacity, ",\n";
 			print $CFGFILE "\n";
 
+			# timing protection
+			print $CFGFILE "\t\t.budget = ", $budget, ",\n";
+			print $CFGFILE "\t\t.timeframe = ", $timeframe, ",\n";
+			print $CFGFILE "\n";
+
 			print $CFGFILE "\t\t.base_prio = ", $task->{prio}, ",\n";
 			print $CFGFILE "\t\t.elev_prio = ";
 			# elevated prios are used for two purposes:
@@ -1028,6 +1095,9 @@ sub gen_config
 		# ISRs
 		for my $isr (@{$part->{isr}}) {
 			my $vector;
+			my $period = 0;		# default: no ISR server
+			my $budget = 0;		# default: no execution budget
+			my $timeframe = 0;	# default: no inter-arrival time protection
 
 			my $blocking = 0;
 			if (defined $isr->{blocking} && $isr->{blocking} eq "yes") {
@@ -1079,6 +1149,21 @@ sub gen_config
 			print $CFGFILE "\t\t.max_activations = 1, /* not used */\n";
 			print $CFGFILE "\n";
 
+			# timing protection, ISR server if both budget and period are set
+			if (defined $isr->{period}) {
+				$period = $isr->{period};
+			}
+			if (defined $isr->{budget}) {
+				$budget = $isr->{budget};
+			}
+			if (defined $isr->{timeframe}) {
+				$timeframe = $isr->{timeframe};
+			}
+			print $CFGFILE "\t\t.period = ", $period, ",\n";
+			print $CFGFILE "\t\t.budget = ", $budget, ",\n";
+			print $CFGFILE "\t\t.timeframe = ", $timeframe, ",\n";
+			print $CFGFILE "\n";
+
 			# invoke block
 			my $activatable = gen_invoke($CFGFILE, $reloc, $isr->{invoke}[0], $elf_file);
 
@@ -1320,6 +1405,93 @@ sub gen_config
 	print $CFGFILE "};\n";
 	print $CFGFILE "\n";
 
+	# iterate IPEV groups in partitions, targets are sorted by CPU
+	my %part_cpu;
+	for my $part (@{$sys->{partition}}) {
+		my $cpu = $part->{cpu};
+		if (!defined $cpu) {
+			$cpu = 0;
+		}
+		if ($cpu >= $num_cpus) {
+			die "error: partition '", $part->{name}, "' on CPU ", $cpu,
+			    " out of bounds\n";
+		}
+		$part_cpu{$part->{name}} = $cpu;
+	}
+	my @ipev_group_targets;
+	my @ipev_group_slices;
+	for my $part (@{$sys->{partition}}) {
+		my $group_id = 0;
+		for my $group (@{$part->{ipev_group}}) {
+			my %slices;
+			if (!defined $group->{ipev}) {
+				die "error: IPEV group ", $group_id, " in partition '", $part->{name},
+				    "': no targets\n";
+			}
+			for my $ipev (@{$group->{ipev}}) {
+				my $ipev_part = $ipev->{partition};
+				my $ipev_task = $ipev->{task};
+				my $ipev_bit  = $ipev->{bit};
+
+				if ($ipev_bit < 0 || $ipev_bit > 31) {
+					die "error: IPEV group ", $group_id, " in partition '", $part->{name},
+					    "': bit out of bounds (0..31)\n";
+				}
+				if (!defined $known_tasks{$ipev_part . "::" . $ipev_task}) {
+					die "error: IPEV group ", $group_id, " in partition '", $part->{name},
+					    "': partition or task '", $ipev_part, "' not found\n";
+				}
+				push(@{$slices{$part_cpu{$ipev_part}}}, $ipev);
+			}
+
+			my @slice = ();
+			for (my $cpu = 0; $cpu < $num_cpus; $cpu++) {
+				if (!defined $slices{$cpu}) {
+					push(@slice, [0, 0]);
+					next;
+				}
+				push(@slice, [scalar @ipev_group_targets, scalar @{$slices{$cpu}}]);
+				push(@ipev_group_targets, @{$slices{$cpu}});
+			}
+			push(@ipev_group_slices, [$part->{name}, $group_id, \@slice]);
+			$group_id++;
+		}
+	}
+
+	print $CFGFILE "/* IPEV group targets */\n";
+	print $CFGFILE "const struct ipev_cfg ipev_group_target_cfg[", scalar @ipev_group_targets, "] = {\n";
+	my $target_id = 0;
+	for my $ipev (@ipev_group_targets) {
+		my $ipev_part = $ipev->{partition};
+		my $ipev_task = $ipev->{task};
+		my $ipev_bit  = $ipev->{bit};
+		my $ipev_global_task_id = $known_tasks{$ipev_part . "::" . $ipev_task};
+		print $CFGFILE "\t/* target ", $target_id, " */ {\n";
+		print $CFGFILE "\t\t.global_task_id = ", $ipev_global_task_id, ", /* part '", $ipev_part, "' task '", $ipev_task, "' */\n";
+		print $CFGFILE "\t\t.mask_bit = ", $ipev_bit, ", /* bit ", $ipev_bit, " */\n";
+		print $CFGFILE "\t},\n";
+		$target_id++;
+	}
+	print $CFGFILE "};\n";
+	print $CFGFILE "\n";
+
+	print $CFGFILE "/* IPEV group table */\n";
+	print $CFGFILE "const struct ipev_group_cfg ipev_group_cfg[", $num_ipev_groups, "] = {\n";
+	for my $g (@ipev_group_slices) {
+		my ($part_name, $group_id, $slice) = @$g;
+		print $CFGFILE "\t/* ipev group ", $group_id, " in partition '", $part_name, "' */ {\n";
+		print $CFGFILE "\t\t.cpu = {\n";
+		for (my $cpu = 0; $cpu < $num_cpus; $cpu++) {
+			my ($first, $num) = @{$slice->[$cpu]};
+			next if ($num == 0);
+			print $CFGFILE "\t\t\t[", $cpu, "] = { .targets = &ipev_group_target_cfg[", $first, "], .num_targets = ", $num, " },\n";
+		}
+		print $CFGFILE "\t\t},\n";
+		print $CFGFILE "\t},\n";
+	}
+	print $CFGFILE "};\n";
+	print $CFGFILE "\n";
+
 	# iterate counters
 	print $CFGFILE "/* global counter table */\n";
 	print $CFGFILE "const uint8_t num_counters __section_cfg = ", $num_counters, ";\n";
@@ -1654,6 +1826,82 @@ sub gen_config
 					$sta_id++;
 				}
 
+				# expiry points with more than one action use a dispatch table
+				my $num_a = 0;
+				$num_a += @{$expiry->{action_task}} if ($expiry->{action_task});
+				$num_a += @{$expiry->{action_hook}} if ($expiry->{action_hook});
+				$num_a += @{$expiry->{action_event}} if ($expiry->{action_event});
+				if ($num_a > 1) {
+					my @d_tasks;
+					my @d_event_tasks;
+					my %d_event_masks;
+
+					for my $a (@{$expiry->{action_task}}) {
+						my $n = $a->{partition} . "::" . $a->{task};
+
+						if (!defined $known_tasks{$n}) {
+							die "task '" . $n . "' does not exists\n";
+						}
+						push(@d_tasks, "&task_dyn_part_" . $part_cnt . "[" . $known_local_tasks{$n} . "], /* partition '" . $a->{partition} . "' task '" . $a->{task} . "' */");
+					}
+					my $d_num_tasks = @d_tasks;
+					for my $a (@{$expiry->{action_hook}}) {
+						my $n = $a->{partition} . "::" . $a->{hook};
+
+						if (!defined $known_hooks{$n}) {
+							die "hook '" . $n . "' does not exists\n";
+						}
+						push(@d_tasks, "&task_dyn_part_" . $part_cnt . "[" . $known_local_hooks{$n} . "], /* partition '" . $a->{partition} . "' hook '" . $a->{hook} . "' */");
+					}
+					my $d_num_hooks = @d_tasks - $d_num_tasks;
+					for my $a (@{$expiry->{action_event}}) {
+						my $n = $a->{partition} . "::" . $a->{task};
+
+						if (!defined $known_tasks{$n}) {
+							die "task '" . $n . "' does not exists\n";
+						}
+						# merge all events to the same task
+						if (!defined $d_event_masks{$n}) {
+							push(@d_event_tasks, $a);
+							$d_event_masks{$n} = 0;
+						}
+						$d_event_masks{$n} |= 1 << $a->{bit};
+					}
+					if (($d_num_tasks > 255) || ($d_num_hooks > 255) || (@d_event_tasks > 255)) {
+						die "schedule table '" . $schedtab->{name} . "' expiry point at offset " . $expiry->{offset} . " has too many actions\n";
+					}
+
+					my $d = "\t/* #" . $num_dispatches . ": schedule table '" . $schedtab->{name} . "' offset " . $expiry->{offset} . " */ {\n";
+					$d .= "\t\t.num_tasks = " . $d_num_tasks . ",\n";
+					$d .= "\t\t.num_hooks = " . $d_num_hooks . ",\n";
+					$d .= "\t\t.num_events = " . @d_event_tasks . ",\n";
+					if (@d_tasks > 0) {
+						$d .= "\t\t.tasks = &schedtab_dispatch_task_cfg[" . @dispatch_tasks . "],\n";
+					}
+					if (@d_event_tasks > 0) {
+						$d .= "\t\t.events = &schedtab_event_cfg[" . @dispatch_events . "],\n";
+					}
+					$d .= "\t},\n";
+					push(@dispatches, $d);
+					push(@dispatch_tasks, @d_tasks);
+					for my $a (@d_event_tasks) {
+						my $n = $a->{partition} . "::" . $a->{task};
+						push(@dispatch_events, "\t{ /* partition '" . $a->{partition} . "' task '" . $a->{task} . "' */\n" .
+						                       "\t\t.task = &task_dyn_part_" . $part_cnt . "[" . $known_local_tasks{$n} . "],\n" .
+						                       "\t\t.mask = " . sprintf("0x%08x", $d_event_masks{$n}) . ",\n" .
+						                       "\t},\n");
+					}
+
+					# emit SCHEDTAB_ACTION_DISPATCH
+					$sta_actions{$sta_id} = "SCHEDTAB_ACTION_DISPATCH";
+					$sta_arg5s{$sta_id} = "&schedtab_dispatch_cfg[" . $num_dispatches . "]";
+					$sta_id++;
+					$num_dispatches++;
+
+					$last_o = $expiry->{offset};
+					next;
+				}
+
 				# generate in order: tasks, hooks, events (required by SWS_Os_00412)
 				for my $a (@{$expiry->{action_task}}) {
 					my $n = $a->{partition} . "::" . $a->{task};
@@ -1726,6 +1974,29 @@ sub gen_config
 
 
 
+	# dispatch tables of expiry points with multiple actions
+	if ($num_dispatches > 0) {
+		print $CFGFILE "/* schedtab dispatch tables */\n";
+		if (@dispatch_tasks > 0) {
+			print $CFGFILE "static struct task * const schedtab_dispatch_task_cfg[", scalar @dispatch_tasks, "] = {\n";
+			for my $t (@dispatch_tasks) {
+				print $CFGFILE "\t", $t, "\n";
+			}
+			print $CFGFILE "};\n";
+			print $CFGFILE "\n";
+		}
+		if (@dispatch_events > 0) {
+			print $CFGFILE "static const struct schedtab_event_cfg schedtab_event_cfg[", scalar @dispatch_events, "] = {\n";
+			print $CFGFILE @dispatch_events;
+			print $CFGFILE "};\n";
+			print $CFGFILE "\n";
+		}
+		print $CFGFILE "static const struct schedtab_dispatch_cfg schedtab_dispatch_cfg[", $num_dispatches, "] = {\n";
+		print $CFGFILE @dispatches;
+		print $CFGFILE "};\n";
+		print $CFGFILE "\n";
+	}
+
 	# iterate schedule tables per partition
 	print $CFGFILE "/* schedtab_action table */\n";
 	print $CFGFILE "const struct schedtab_action_cfg schedtab_action_cfg[", $sta_id, "] = {\n";
@@ -1752,6 +2023,10 @@ sub gen_config
 			# arg4 decodes optional time values
 			print $CFGFILE "\t\t.u.time = ", $sta_arg4s{$i}, ",\n";
 		}
+		if (defined $sta_arg5s{$i}) {
+			# arg5 is used for optional dispatch tables
+			print $CFGFILE "\t\t.u.dispatch = ", $sta_arg5s{$i}, ",\n";
+		}
 		print $CFGFILE "\t},\n";
 	}
 	print $CFGFILE "};\n";
@@ -1759,6 +2034,83 @@ sub gen_config
 
 
 
+	# first-level handlers of user ISRs
+	my @known_isrs_flh;
+	my $num_isr_flhs = 0;
+	for my $part (@{$sys->{partition}}) {
+		for my $isr (@{$part->{isr}}) {
+			if (defined $isr->{first_level}) {
+				$num_isr_flhs++;
+			}
+		}
+	}
+	print $CFGFILE "/* first-level handlers of user ISRs */\n";
+	print $CFGFILE "const struct isr_flh_cfg isr_flh_cfg[", ($num_isr_flhs > 0 ? $num_isr_flhs : 1), "] = {\n";
+	$part_cnt = $num_cpus;	# skip idle partitions
+	{
+		my $flh_id = 0;
+		for my $part (@{$sys->{partition}}) {
+			for my $isr (@{$part->{isr}}) {
+				next if (!defined $isr->{first_level});
+
+				my $fl = $isr->{first_level}[0];
+				my $n = $part->{name} . "::" . $fl->{task};
+				my $e = $fl->{bit};
+				my $ack_func = 0;
+				my $ack_arg0 = 0;
+				my $ack_func_name = "NULL";
+				my $ack_arg0_name = "NULL";
+
+				if (!defined $known_tasks{$n}) {
+					die "error: first-level handler of ISR '", $isr->{name}, "' in partition '", $part->{name},
+					    "': task '", $fl->{task}, "' not found\n";
+				}
+				if (!grep { $_->{name} eq $fl->{task} && defined $_->{blocking} && $_->{blocking} eq "yes" } @{$part->{task}}) {
+					die "error: first-level handler of ISR '", $isr->{name}, "' in partition '", $part->{name},
+					    "': task '", $fl->{task}, "' cannot wait for events\n";
+				}
+				if ($e < 0 || $e > 31) {
+					die "error: first-level handler of ISR '", $isr->{name}, "' in partition '", $part->{name},
+					    "': bit out of bounds (0..31)\n";
+				}
+
+				if (defined $fl->{ack}) {
+					$ack_func_name = $fl->{ack};
+					$ack_arg0_name = defined $fl->{arg} ? $fl->{arg} : "0";
+					if ($reloc) {
+						$ack_func = sym_eval(\%symhash_kern, $fl->{ack});
+						if (defined $fl->{arg}) {
+							$ack_arg0 = sym_eval(\%symhash_kern, $fl->{arg});
+						}
+					}
+				}
+
+				print $CFGFILE "\t/* ISR '", $isr->{name}, "' in partition '", $part->{name}, "' */ {\n";
+				print $CFGFILE "\t\t.ack = (void*)", hexify($ack_func), ", /* ", $ack_func_name, " */\n";
+				print $CFGFILE "\t\t.ack_arg0 = (void*)", hexify($ack_arg0), ", /* ", $ack_arg0_name, " */\n";
+				print $CFGFILE "\t\t.task = &task_dyn_part_", $part_cnt, "[", $known_local_tasks{$n}, "], /* task '", $fl->{task}, "' */\n";
+				print $CFGFILE "\t\t.isr_task_cfg = &task_cfg[", $known_isrs{$part->{name} . "::" . $isr->{name}}, "],\n";
+				print $CFGFILE "\t\t.event_bit = ", $e, ",\n";
+				print $CFGFILE "\t},\n";
+
+				$known_isrs_flh[$isr->{vector}] = $flh_id;
+				$flh_id++;
+			}
+			$part_cnt++;
+		}
+	}
+	if ($num_isr_flhs == 0) {
+		print $CFGFILE "\t/* dummy */ {\n";
+		print $CFGFILE "\t\t.ack = NULL,\n";
+		print $CFGFILE "\t\t.ack_arg0 = NULL,\n";
+		print $CFGFILE "\t\t.task = NULL,\n";
+		print $CFGFILE "\t\t.isr_task_cfg = NULL,\n";
+		print $CFGFILE "\t\t.event_bit = 0,\n";
+		print $CFGFILE "\t},\n";
+	}
+	print $CFGFILE "};\n";
+	print $CFGFILE "\n";
+
 	# ISR call table
 	print $CFGFILE "/* ISR call table */\n";
 	print $CFGFILE "const struct isr_cfg isr_cfg[", $num_isrs, "] = {\n";
@@ -1782,7 +2134,10 @@ sub gen_config
 	}
 	for (my $vector = 0; $ vector < $num_isrs; $vector++){
 		print $CFGFILE "\t/* ISR ", $vector, " */ {\n";
-		if (defined $known_isrs_user[$vector]) {
+		if (defined $known_isrs_flh[$vector]) {
+			print $CFGFILE "\t\t.func = kernel_isr_flh,\n";
+			print $CFGFILE "\t\t.arg0 = &isr_flh_cfg[", $known_isrs_flh[$vector], "], /* user ISR, first-level handler */\n";
+		} elsif (defined $known_isrs_user[$vector]) {
 			print $CFGFILE "\t\t.func = kernel_wake_isr_task,\n";
 			print $CFGFILE "\t\t.arg0 = &task_cfg[", $known_isrs_user[$vector] , "], /* user ISR */\n";
 		} else {
@@ -1916,6 +2271,12 @@ sub gen_config
 				die "shm_access '" . $shm . "' in partition '" . $pn . "' refers to unknown SHM\n";
 			}
 			print $CFGFILE "\t\t.shm_cfg = &shm_cfg[", $known_shms{$shm}, "],\n";
+			# write access defaults to the SHM type: RAM is writable, ROM not
+			my $write = $known_shm_writable{$shm};
+			if (defined $shm_acc->{write}) {
+				$write = !!(number $shm_acc->{write}) + 0;
+			}
+			print $CFGFILE "\t\t.write = ", $write, ",\n";
 
 			print $CFGFILE "\t},\n";
 			$shm_acc_array_index++;
@@ -1979,13 +2340,13 @@ sub gen_config
 	print $CFGFILE "/** cross-core IPI jobs (num_actions x (num_cpus-1) x num_cpus) */\n";
 	print $CFGFILE "const uint8_t num_ipi_actions __section_cfg = ", $num_actions, ";\n";
 	for (my $cpu = 0; $cpu < $num_cpus; $cpu++) {
-		print $CFGFILE "struct ipi_action ipi_actions_core_", $cpu, "[", $num_actions*($num_cpus-1), "] __section_context_core(", $cpu, ");\n";
+		print $CFGFILE "struct ipi_action ipi_actions_core_", $cpu, "[", $num_actions*($num_cpus-1), "] __section_shared_core(", $cpu, ");\n";
 	}
 	print $CFGFILE "\n";
 
 	print $CFGFILE "/** per-core IPI state */\n";
 	for (my $cpu = 0; $cpu < $num_cpus; $cpu++) {
-		print $CFGFILE "struct ipi_state ipi_state_core_", $cpu, " __section_context_core(", $cpu, ");\n";
+		print $CFGFILE "struct ipi_state ipi_state_core_", $cpu, " __section_shared_core(", $cpu, ");\n";
 	}
 	print $CFGFILE "\n";
 
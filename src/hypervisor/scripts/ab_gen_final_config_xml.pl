@@ -187,7 +187,7 @@ sub ab_gen_final_config_xml
 	my $cfgfile = shift;
 	my $sys = XMLin($xmlfile,
 					KeyAttr => { },
-					ForceArray => ['partition', 'task', 'hook', 'invokable', 'layout', 'invoke', 'kldd', 'isr', 'ipev', 'counter', 'range'],
+					ForceArray => ['partition', 'task', 'hook', 'invokable', 'layout', 'invoke', 'kldd', 'isr', 'ipev', 'counter', 'range', 'data'],
 					) or die "opening and parsing failed!\n";
 
 	my $num_isrs = number $sys->{target}->{isrs};
@@ -228,6 +228,9 @@ sub ab_gen_final_config_xml
 		my $user_exception_state = 0;
 		my $sda1_base = 0;
 		my $sda2_base = 0;
+		my $data_rom = 0;
+		my $data_ram = 0;
+		my $data_size = 0;
 
 		my $layout = $part->{layout}[0];
 
@@ -250,6 +253,13 @@ sub ab_gen_final_config_xml
 		if (defined $part->{sda2_base}) {
 			$sda2_base = sym_eval(\%symhash_part, $part->{sda2_base});
 		}
+		if (defined $layout->{data}) {
+			# .data load image, unpacked by the kernel if compressed
+			my $data = $layout->{data}[0];
+			$data_rom = sym_eval(\%symhash_part, $data->{rom});
+			$data_ram = sym_eval(\%symhash_part, $data->{start});
+			$data_size = sym_eval(\%symhash_part, $data->{end}) - $data_ram;
+		}
 
 		# partition layout
 		print $CFGFILE "\t\t<user_sched_state>", hexify($user_sched_state),"</user_sched_state>\n";
@@ -257,6 +267,9 @@ sub ab_gen_final_config_xml
 		print $CFGFILE "\t\t<user_exception_state>", hexify($user_exception_state),"</user_exception_state>\n";
 		print $CFGFILE "\t\t<sda1_base>", hexify($sda1_base),"</sda1_base>\n";
 		print $CFGFILE "\t\t<sda2_base>", hexify($sda2_base),"</sda2_base>\n";
+		print $CFGFILE "\t\t<data_rom>", hexify($data_rom),"</data_rom>\n";
+		print $CFGFILE "\t\t<data_ram>", hexify($data_ram),"</data_ram>\n";
+		print $CFGFILE "\t\t<data_size>", hexify($data_size),"</data_size>\n";
 
 		# Memory ranges (for of them)
 		my $r = 0;
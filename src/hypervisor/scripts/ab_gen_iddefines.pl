@@ -102,7 +102,7 @@ if (!defined $sysxmlfile) {
 my $all = XMLin($sysxmlfile,
 				KeyAttr => { },
 				ForceArray => ['partition', 'layout', 'hook', 'task', 'isr',
-				               'kldd', 'ipev', 'counter_access', 'shm_access',
+				               'kldd', 'ipev', 'ipev_group', 'counter_access', 'shm_access',
 				               'rpc', 'invokable',
 				               'alarm', 'wait_queue', 'sched_table'],
 				) or die "opening and parsing of '$sysxmlfile' failed!\n";
@@ -284,6 +284,16 @@ for my $part (@{$sys->{partition}}) {
 	print $OUTFILE "#define CFG_NUM_IPEVS\t", $ipev_id, "\n";
 	print $OUTFILE "\n";
 
+	# iterate IPEV groups
+	my $ipev_group_id = 0;
+	for my $ipev_group (@{$part->{ipev_group}}) {
+		my $name = $ipev_group->{name};
+		print $OUTFILE "#define CFG_IPEV_GROUP_", $name, "\t", $ipev_group_id, "\n";
+		$ipev_group_id++;
+	}
+	print $OUTFILE "#define CFG_NUM_IPEV_GROUPS\t", $ipev_group_id, "\n";
+	print $OUTFILE "\n";
+
 	# iterate counters
 	my $counter_id = 0;
 	for my $counter (@{$part->{counter_access}}) {
@@ -31,6 +31,13 @@ my $minalign;
 my $alignedmode;
 my $maxalign;
 my $alignshift;
+my $subregions = 0;	# ARMv7 MPU: 8 subregions per window
+my $minwindow;		# smallest window with subregions
+
+# memory requests in configuration order
+my @requests;
+# if set, pool allocations are deferred to pack_requests()
+my $packing = 0;
 
 
 my $xmlfile;
@@ -56,6 +63,33 @@ sub hexify
 	return sprintf("0x%08x", shift);
 }
 
+# Evaluate a "cached" attribute (cache policy):
+#  0: uncached, strongly ordered
+#  1: cached, write-back
+#  2: cached, write-through
+#  3: uncached normal memory
+#  4: uncached device memory
+# Usage: $c = cache_policy($attr, $errorname)
+sub cache_policy
+{
+	my $attr = shift;
+	my $errorname = shift;
+	my $c = number $attr;
+
+	if ($c < 0 || $c > 4) {
+		die "error: $errorname: invalid 'cached' attribute '$attr'\n";
+	}
+	return $c;
+}
+
+# Check if a cache policy allocates in the cache (write-back or write-through)
+sub is_cached
+{
+	my $c = shift;
+
+	return $c == 1 || $c == 2;
+}
+
 # Align a value
 # Usage: $val = alignup($val, 0x1000);
 sub alignup
@@ -105,6 +139,61 @@ sub find_largest_aligned_chunk
 	die "internal error, cannot happen";
 }
 
+# find a single ARMv7 MPU window covering a memory range with subregions.
+# Windows have 8 subregions of 1/8 of the window size that can be disabled.
+# Usage: ($base, $wsize, $srd) = find_subregion_window($start, $size)
+# returns an empty list if no such window exists
+sub find_subregion_window
+{
+	my $start = shift;
+	my $size = shift;
+
+	for (my $wsize = $minwindow; $wsize <= $maxalign; $wsize <<= 1) {
+		next if ($wsize < $size);
+
+		my $sub = $wsize / 8;
+		if (($start & ($sub - 1)) != 0 || ($size & ($sub - 1)) != 0) {
+			# larger windows have larger subregions
+			return ();
+		}
+
+		my $base = $start & ~($wsize - 1);
+		next if ($start + $size > $base + $wsize);
+
+		my $first = ($start - $base) / $sub;
+		my $num = $size / $sub;
+		my $srd = 0xff & ~(((1 << $num) - 1) << $first);
+		return ($base, $wsize, $srd);
+	}
+
+	return ();
+}
+
+# size and placement constraints of a memory request in a pool
+# Usage: ($size, $align, $boundary) = mpu_fit($minsize, $align)
+# the allocation must not cross a $boundary aligned address (if non-zero)
+sub mpu_fit
+{
+	my $minsize = shift;
+	my $align = shift;
+
+	if (!$subregions) {
+		return (alignup($minsize, $align), $align, 0);
+	}
+
+	# smallest window covering the request, rounded up to its subregions
+	my $wsize = $minwindow;
+	while ($wsize < $minsize) {
+		$wsize <<= 1;
+	}
+	my $sub = $wsize / 8;
+	if ($align < $sub) {
+		$align = $sub;
+	}
+
+	return (alignup($minsize, $sub), $align, $wsize);
+}
+
 ################################################################################
 
 # Add hardware element to list (fix or pool)
@@ -173,47 +262,207 @@ sub add_hw_node
 		$exec = 0 + !!(number $node->{exec});
 	}
 	if (defined $node->{cached}) {
-		$cached = 0 + !!(number $node->{cached});
+		$cached = cache_policy($node->{cached}, "$hwxmlfile: <$type> '$name'");
 	}
 
 	if ($verbose) {
 		print "hw.$type: $name, start: " . hexify($start) . ", size: " . hexify($size). ", rwx: $read$write$exec, cached: $cached\n";
 	}
-	$hwhash{$name} = [ $ispool, $start, $size, $allocptr, $read, $write, $exec, $cached ];
+	# pools keep a list of free holes [start, end) for allocations
+	$hwhash{$name} = [ $ispool, $start, $size, $allocptr, $read, $write, $exec, $cached,
+	                   [ [ $start, $start + $size ] ] ];
 }
 
 ################################################################################
 
 # Allocate memory from pool (or assign fix)
-# usage: ($start, $size) = allocate_from_pool($res, $poolname, $minsize, $align, $errorname)
+# The allocation takes the first free hole of the pool that fits. With a
+# non-zero $boundary, the allocation must not cross a $boundary aligned
+# address.
+# usage: ($start, $size) = allocate_from_pool($res, $poolname, $size, $align, $boundary, $errorname)
 sub allocate_from_pool
+{
+	my $res = shift;
+	my $poolname = shift;
+	my $size = shift;
+	my $align = shift;
+	my $boundary = shift;
+	my $errorname = shift;
+
+	if (!$res->[0]) {
+		# not a pool, return
+		return ($res->[1], $res->[2]);
+	}
+
+	# allocate from pool
+	my $holes = $res->[8];
+	my $largest = 0;
+	for (my $i = 0; $i < @{$holes}; $i++) {
+		my ($hstart, $hend) = @{$holes->[$i]};
+		if ($hend - $hstart > $largest) {
+			$largest = $hend - $hstart;
+		}
+
+		my $start = alignup($hstart, $align);
+		if ($boundary && ($start & ($boundary - 1)) + $size > $boundary) {
+			$start = alignup($start, $boundary);
+		}
+		next if ($start + $size > $hend);
+
+		# split hole, keep the padding in front as new hole
+		my @split;
+		if ($start > $hstart) {
+			push @split, [ $hstart, $start ];
+		}
+		if ($start + $size < $hend) {
+			push @split, [ $start + $size, $hend ];
+		}
+		splice(@{$holes}, $i, 1, @split);
+
+		# allocation pointer is the high water mark
+		if ($start + $size > $res->[3]) {
+			$res->[3] = $start + $size;
+		}
+
+		return ($start, $size);
+	}
+
+	die "error: $errorname: cannot allocate $size bytes from '$poolname', largest free hole has $largest bytes\n";
+}
+
+# Request memory from pool (or fix), $finish is called with ($start, $size)
+# usage: request_memory($res, $poolname, $minsize, $align, $errorname, $finish, $partname)
+sub request_memory
 {
 	my $res = shift;
 	my $poolname = shift;
 	my $minsize = shift;
 	my $align = shift;
 	my $errorname = shift;
+	my $finish = shift;
+	my $partname = shift;
+
+	my ($size, $walign, $boundary) = mpu_fit($minsize, $align);
+	my $req = { res => $res, poolname => $poolname, minsize => $minsize,
+	            align => $align, size => $size, walign => $walign,
+	            boundary => $boundary, errorname => $errorname,
+	            finish => $finish, part => $partname,
+	            order => scalar @requests };
+	push @requests, $req;
+
+	if (!$packing) {
+		place_request($req);
+	}
+}
+
+# Allocate a memory request and finish it
+sub place_request
+{
+	my $req = shift;
+
+	my ($start, $size) = allocate_from_pool($req->{res}, $req->{poolname},
+	                                        $req->{size}, $req->{walign},
+	                                        $req->{boundary}, $req->{errorname});
+	$req->{start} = $start;
+	$req->{finish}->($start, $size);
+}
+
+# Packing pass: allocate deferred pool requests with the largest windows
+# and alignments first, so smaller requests fill the padding holes.
+# Requests referring to fixed resources or SHMs are resolved afterwards.
+sub pack_requests
+{
+	my @pending = grep { !defined $_->{start} } @requests;
+
+	my @pool = grep { $_->{res}->[0] } @pending;
+	for my $req (sort { $b->{boundary} <=> $a->{boundary} ||
+	                    $b->{walign} <=> $a->{walign} ||
+	                    $b->{size} <=> $a->{size} ||
+	                    $a->{order} <=> $b->{order} } @pool) {
+		place_request($req);
+	}
+
+	for my $req (grep { !$_->{res}->[0] } @pending) {
+		place_request($req);
+	}
+
+	$packing = 0;
+}
+
+# Count MPU windows for a memory range with the greedy power-of-two split
+sub count_greedy_windows
+{
+	my $start = shift;
+	my $size = shift;
+	my $n = 0;
+
+	while ($size > 0) {
+		my $chunk = find_largest_aligned_chunk($start, $size);
+		$start += $chunk;
+		$size -= $chunk;
+		$n++;
+	}
+
+	return $n;
+}
 
-	my $start;
-	my $size;
-
-	if ($res->[0]) {
-		# allocate from pool
-		$start = alignup($res->[3], $align);
-		$size = alignup($minsize, $align);
-		my $realsize = $start + $minsize - $res->[3];
-		my $free = $res->[1] + $res->[2] - $res->[3];
-		if ($realsize > $free) {
-			die "error: $errorname: cannot allocate $realsize bytes from '$poolname', only $free bytes left\n";
+# Report wasted memory and MPU windows, compared to a plain bump allocator
+# that aligns each request in configuration order
+# usage: report_waste(\%windows_per_part)
+sub report_waste
+{
+	my $windows = shift;
+	my %ptr;
+	my %requested;
+	my %legacy;
+	my %legacy_windows;
+
+	for my $req (@requests) {
+		my $res = $req->{res};
+		my $start;
+		my $size;
+
+		if ($res->[0]) {
+			my $p = $req->{poolname};
+			if (!defined $ptr{$p}) {
+				$ptr{$p} = $res->[1];
+			}
+			$start = alignup($ptr{$p}, $req->{align});
+			$size = alignup($req->{minsize}, $req->{align});
+			$ptr{$p} = $start + $req->{minsize};
+			$requested{$p} += $req->{minsize};
+		} elsif (defined $legacy{$res}) {
+			# request on SHM
+			($start, $size) = @{$legacy{$res}};
+		} else {
+			$start = $res->[1];
+			$size = $res->[2];
+		}
+		if (defined $req->{shm}) {
+			$legacy{$req->{shm}} = [ $start, $size ];
+		}
+
+		if ($alignedmode && defined $req->{part} && $size > 0 &&
+		    ($start & ($minalign - 1)) == 0 && ($size & ($minalign - 1)) == 0) {
+			$legacy_windows{$req->{part}} += count_greedy_windows($start, $size);
 		}
-		$res->[3] += $realsize;
-	} else {
-		# not a pool, return
-		$start = $res->[1];
-		$size = $res->[2];
 	}
 
-	return ($start, $size);
+	for my $p (sort keys %ptr) {
+		my $res = $hwhash{$p};
+		my $used = $res->[3] - $res->[1];
+		my $old = $ptr{$p} - $res->[1];
+		printf "pool '%s': %d bytes requested, %d bytes used, %d bytes wasted (bump allocator: %d bytes used, %d bytes wasted)\n",
+		       $p, $requested{$p}, $used, $used - $requested{$p}, $old, $old - $requested{$p};
+	}
+
+	if ($alignedmode) {
+		for my $part (sort keys %{$windows}) {
+			my $old = defined $legacy_windows{$part} ? $legacy_windows{$part} : 0;
+			printf "part '%s': %d MPU windows (bump allocator: %d)\n",
+			       $part, $windows->{$part}, $old;
+		}
+	}
 }
 
 ################################################################################
@@ -294,8 +543,8 @@ sub add_rq
 		}
 	}
 	if (defined $node->{cached}) {
-		$cached = 0 + !!(number $node->{cached});
-		if (!$default_cached && $cached) {
+		$cached = cache_policy($node->{cached}, "$xmlfile: <part> '$partname' <rq> '$nodename'");
+		if (!is_cached($default_cached) && is_cached($cached)) {
 			die "error: $xmlfile: <part> '$partname' <rq> '$nodename': 'cached' is set, but not in referenced resource '$poolname'\n";
 		}
 	}
@@ -304,24 +553,29 @@ sub add_rq
 		print "rq: $name, minsize: " . hexify($minsize). ", align: " . hexify($align) . ", rwx: $read$write$exec, cached: $cached\n";
 	}
 
-	# allocate memory resources
-	my ($start, $size) = allocate_from_pool($res, $poolname, $minsize, $align, "<part> '$partname' <node> '$nodename'");
-	my $allocptr = $start;
+	# allocate memory resources, use same structure than %hwhash entries!
+	my $rq = [ 0, 0, 0, 0, $read, $write, $exec, $cached ];
+	$rqhash{$name} = $rq;
+	my $finish = sub {
+		my ($start, $size) = @_;
 
-	if ($verbose) {
-		print "rq: $name, start: " . hexify($start) . ", size: " . hexify($size). ", rwx: $read$write$exec, cached: $cached\n";
-	}
-
-	# use same structure than %hwhash entries!
-	$rqhash{$name} = [ 0, $start, $size, $allocptr, $read, $write, $exec, $cached ];
+		if ($verbose) {
+			print "rq: $name, start: " . hexify($start) . ", size: " . hexify($size). ", rwx: $read$write$exec, cached: $cached\n";
+		}
 
-	# XXX -- add XML attributes for start and size
-	$node->{start} = hexify $start;
-	$node->{size} = hexify $size;
-	$node->{read} = $read;
-	$node->{write} = $write;
-	$node->{exec} = $exec;
-	$node->{cached} = $cached;
+		$rq->[1] = $start;
+		$rq->[2] = $size;
+		$rq->[3] = $start;
+
+		# XXX -- add XML attributes for start and size
+		$node->{start} = hexify $start;
+		$node->{size} = hexify $size;
+		$node->{read} = $read;
+		$node->{write} = $write;
+		$node->{exec} = $exec;
+		$node->{cached} = $cached;
+	};
+	request_memory($res, $poolname, $minsize, $align, "<part> '$partname' <node> '$nodename'", $finish, $partname);
 }
 
 ################################################################################
@@ -398,8 +652,8 @@ sub add_shm
 		}
 	}
 	if (defined $node->{cached}) {
-		$cached = 0 + !!(number $node->{cached});
-		if (!$default_cached && $cached) {
+		$cached = cache_policy($node->{cached}, "$xmlfile: <shm> '$name'");
+		if (!is_cached($default_cached) && is_cached($cached)) {
 			die "error: $xmlfile: <shm> '$name': 'cached' is set, but not in referenced resource '$poolname'\n";
 		}
 	}
@@ -409,24 +663,31 @@ sub add_shm
 		print "shm: $name, minsize: " . hexify($minsize). ", align: " . hexify($align) . ", rwx: $read$write$exec, cached: $cached\n";
 	}
 
-	# allocate memory resources
-	my ($start, $size) = allocate_from_pool($res, $poolname, $minsize, $align, "<shm> '$name'");
-	my $allocptr = $start;
+	# allocate memory resources, use same structure than %hwhash entries!
+	# requirements may refer to the SHM before its allocation
+	my $shm = [ 0, 0, 0, 0, $read, $write, $exec, $cached ];
+	$shmhash{$name} = $shm;
+	my $finish = sub {
+		my ($start, $size) = @_;
 
-	if ($verbose) {
-		print "shm: $name, start: " . hexify($start) . ", size: " . hexify($size). ", rwx: $read$write$exec, cached: $cached\n";
-	}
-
-	# use same structure than %hwhash entries!
-	$shmhash{$name} = [ 0, $start, $size, $allocptr, $read, $write, $exec, $cached ];
+		if ($verbose) {
+			print "shm: $name, start: " . hexify($start) . ", size: " . hexify($size). ", rwx: $read$write$exec, cached: $cached\n";
+		}
 
-	# XXX -- add XML attributes for start and size
-	$node->{start} = hexify $start;
-	$node->{size} = hexify $size;
-	$node->{read} = $read;
-	$node->{write} = $write;
-	$node->{exec} = $exec;
-	$node->{cached} = $cached;
+		$shm->[1] = $start;
+		$shm->[2] = $size;
+		$shm->[3] = $start;
+
+		# XXX -- add XML attributes for start and size
+		$node->{start} = hexify $start;
+		$node->{size} = hexify $size;
+		$node->{read} = $read;
+		$node->{write} = $write;
+		$node->{exec} = $exec;
+		$node->{cached} = $cached;
+	};
+	request_memory($res, $poolname, $minsize, $align, "<shm> '$name'", $finish);
+	$requests[-1]->{shm} = $shm;
 }
 
 ################################################################################
@@ -446,8 +707,8 @@ sub do_memory_allocations
 	$mpu_arch = $hw->{mpu_arch};
 	if ($mpu_arch ne "generic_no_mpu" &&
 	    $mpu_arch ne "generic_mmu_4k" &&
-	    $mpu_arch ne "arm_cortexr4_8regions" &&
-	    $mpu_arch ne "arm_cortexr4_12regions" &&
+	    $mpu_arch !~ /^arm_cortexm[347]_(8|16)regions$/ &&
+	    $mpu_arch !~ /^arm_cortexr[457]_(8|12|16)regions$/ &&
 	    $mpu_arch ne "ppc_e200z4_16tlbs" &&
 	    $mpu_arch ne "ppc_e200z6_32tlbs") {
 		die "error: unsupported MPU architecture '$mpu_arch', " .
@@ -482,10 +743,14 @@ sub do_memory_allocations
 		$maxalign = 0x10000000;	# 256 MB
 		$alignshift = 2;
 	} elsif (substr($mpu_arch, 0, 10) eq "arm_cortex") {
-		$minalign = 256;
+		# ARMv7 MPU: windows of 32 bytes or more, windows of 256 bytes
+		# or more have 8 subregions that can be disabled individually
+		$minalign = 32;
 		$alignedmode = 1;
 		$maxalign = 0x80000000;	# 2 GB (could be 4 GB)
 		$alignshift = 1;
+		$subregions = 1;
+		$minwindow = 256;
 	} else {
 		$minalign = 16;
 		$alignedmode = 0;
@@ -526,6 +791,9 @@ sub do_memory_allocations
 		}
 	}
 
+	# the remaining requests are packed
+	$packing = 1;
+
 	# iterate <shm>
 	for my $shm (@{$mem->{shm}}) {
 		add_shm($shm);
@@ -543,7 +811,10 @@ sub do_memory_allocations
 		}
 	}
 
+	pack_requests();
+
 	# iterate other partitions and requirements to generate MPU window list
+	my %num_windows;
 	for my $part (@{$mem->{part}}) {
 		my $id = 0;
 		my @windows;
@@ -559,6 +830,19 @@ sub do_memory_allocations
 			my $cached = $rq->[7];
 			my $arch = 0;
 
+			if ($subregions && $size > 0) {
+				# single window with disabled subregions, if possible
+				my ($base, $wsize, $srd) = find_subregion_window($start, $size);
+				if (defined $base) {
+					push @windows, {id => $id,
+					                start => hexify($base), size => hexify($wsize),
+					                read => $read, write => $write, exec => $exec,
+					                cached => $cached, arch => hexify($srd)};
+					$id++;
+					next;
+				}
+			}
+
 			while ($size > 0) {
 				my $chunk;
 				if ($alignedmode) {
@@ -587,8 +871,11 @@ sub do_memory_allocations
 			}
 		}
 		$part->{mpu_window} = \@windows;
+		$num_windows{$part->{name}} = $id;
 	}
 
+	report_waste(\%num_windows);
+
 	# create outxmlfile
 	if (defined $outxmlfile) {
 		XMLout($mem,
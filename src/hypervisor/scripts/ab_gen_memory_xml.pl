@@ -6,6 +6,21 @@
 #       on Ubuntu 12.04, try:  sudo apt-get install libxml-simple-perl
 #
 # Usage: ab_gen_memory_xml.pl -s nm-tool -o memory.xml system.xml
+#        ab_gen_memory_xml.pl -s nm-tool -e size-tool -o memory.xml system.xml
+#        ab_gen_memory_xml.pl -s nm-tool -c final_memory.xml system.xml
+#        ab_gen_memory_xml.pl -s nm-tool -z [-k] -o memory.xml system.xml
+#
+# With -e, the partitions' ROM and RAM sizes are estimated from the section
+# sizes of their relocatable app.ro objects, so the dummy relocation link of
+# the applications can be skipped. With -c, the sizes of the final ELF files
+# are checked against the final memory map. The check fails with exit code 2
+# if an estimate was exceeded.
+#
+# With -z, the ROM sections of partitions with a <data> layout element end
+# with the LZ4 compressed .data load image that ab_gen_romimage.pl -z writes,
+# so their size is reduced to the compressed size of the .data image of the
+# dummy link plus the safety margin. With -k, this applies to the kernel, too.
+# Estimates from app.ro keep the uncompressed sizes.
 #
 # azuepke, 2014-08-18: initial (cloned from genconfig.pl)
 # azuepke, 2014-08-19: don't do relocation ourself
@@ -16,6 +31,7 @@
 # azuepke, 2015-06-26: configurable section names
 # azuepke, 2015-08-04: have MPU-architecture
 # azuepke, 2015-08-05: handle cached attribute
+# agent, 2026-10-18: estimate sizes from relocatable objects
 
 
 use strict;
@@ -26,9 +42,13 @@ use Data::Dumper;
 use POSIX;
 
 # tool version ID
-my $VERSION = "ab_gen_memory_xml.pl 2015-08-05";
+my $VERSION = "ab_gen_memory_xml.pl 2026-10-18";
 
 my $nm = 'nm';
+my $size_tool;		# set by -e: estimate sizes from app.ro
+my $compress = 0;	# set by -z: size of compressed .data load images
+my $compress_kernel = 0;	# set by -k: compressed kernel .data as well
+my $slack = 5;		# safety margin of estimates in percent
 my $num_cpus;
 my $mpu_arch;
 
@@ -149,6 +169,29 @@ sub hexify
 	return sprintf("0x%08x", shift);
 }
 
+# Cache policy of a "cached" attribute, either a number or a name:
+#  0 or "so":     uncached, strongly ordered
+#  1 or "wb":     cached, write-back (write-allocate on ARM SMP cores)
+#  2 or "wt":     cached, write-through
+#  3 or "nc":     uncached normal memory (write combining, DMA buffers)
+#  4 or "device": uncached device memory
+# Usage: $c = cache_policy($attr, $errorname)
+sub cache_policy
+{
+	my $attr = shift;
+	my $errorname = shift;
+	my %names = ( so => 0, wb => 1, wt => 2, nc => 3, device => 4 );
+
+	if (defined $names{lc $attr}) {
+		return $names{lc $attr};
+	}
+	my $c = number $attr;
+	if ($c < 0 || $c > 4) {
+		die "error: $errorname: invalid 'cached' attribute '$attr'\n";
+	}
+	return $c;
+}
+
 # Get ROM and RAM sizes from ELF binary
 # Usage: @sizes = get_required_rom_and_ram_from_elf($filename, $layout, $default_cpu)
 sub get_required_rom_and_ram_from_elf {
@@ -187,6 +230,308 @@ sub get_required_rom_and_ram_from_elf {
 	return @sizes;
 }
 
+# Read section sizes from an object file (uses "size -A" internally)
+# Usage: my @sections = sec_readsizes('/path/to/size', 'file.o');
+sub sec_readsizes
+{
+	my @inputstream;
+	my @sections;
+
+	open2(\*INPUTSTREAM, undef, $_[0], '-A', '-d', $_[1]);
+	@inputstream = <INPUTSTREAM>;
+	close INPUTSTREAM;
+
+	foreach (@inputstream) {
+		# ".text   1234   0"
+		if (/^(\S+)\s+(\d+)\s+\d+\s*$/) {
+			push @sections, [ $1, int $2 ];
+		}
+	}
+
+	return @sections;
+}
+
+# Round size up to a multiple of 8 (like the section alignment in app_gcc.ld.S)
+sub align8
+{
+	return (shift() + 7) & ~7;
+}
+
+# Add the safety margin to an estimate
+sub add_slack
+{
+	my $size = shift;
+	return align8($size + int(($size * $slack + 99) / 100));
+}
+
+# Estimate ROM and RAM sizes from a relocatable object
+# Usage: @sizes = estimate_rom_and_ram_from_ro($filename, $layout, $default_cpu, $partname)
+# The estimate follows the default application linker script: ROM keeps text,
+# read-only data and the initial values of the data sections, RAM keeps data
+# and bss. This requires exactly one "rom" and one "ram" section in the layout.
+sub estimate_rom_and_ram_from_ro {
+	my $ro_file = shift;
+	my $layout = shift;
+	my $default_cpu = shift;
+	my $partname = shift;
+
+	my $text = 0;
+	my $data = 0;
+	my $bss = 0;
+
+	for my $sec (sec_readsizes($size_tool, $ro_file)) {
+		my ($name, $size) = @{$sec};
+
+		if ($name =~ /^\.(sbss\.kernel_shared|kernel_shared)/) {
+			# kernel shared data is kept in RAM only
+			$bss += align8($size);
+		} elsif ($name =~ /^\.(text|rodata|sdata2|sbss2|srodata|sdata\.rodata|gnu\.linkonce\.s2|gnu\.linkonce\.sr)/) {
+			$text += align8($size);
+		} elsif ($name =~ /^\.(data|sdata|gnu\.linkonce\.s\.)/) {
+			$data += align8($size);
+		} elsif ($name =~ /^\.(bss|sbss|scommon)/ || $name eq 'COMMON') {
+			$bss += align8($size);
+		} elsif ($name !~ /^\.(comment|debug|note|stab|rel|symtab|strtab|shstrtab|ARM\.attributes|gnu\.attributes|gnu_debuglink|mdebug|pdr)/) {
+			# orphaned sections like .eh_frame end up behind the text
+			$text += align8($size);
+		}
+	}
+
+	my @sizes;
+	my $num_rom = 0;
+	my $num_ram = 0;
+
+	for my $memory (@{$layout->{section}}) {
+		my $name = $memory->{name};
+		my $type = $memory->{type};
+		my $cpu = $default_cpu;
+		if (defined $memory->{cpu}) {
+			$cpu = number $memory->{cpu};
+		}
+
+		# ignore sections of unconfigured CPUs
+		if ($cpu >= $num_cpus) {
+			next;
+		}
+
+		my $required_size;
+		if ($type eq "rom") {
+			$required_size = add_slack($text + $data);
+			$num_rom++;
+		} else {
+			$required_size = add_slack($data + $bss);
+			$num_ram++;
+		}
+
+		push @sizes, [ $name, $type, $cpu, $required_size ];
+	}
+
+	if ($num_rom != 1 || $num_ram != 1) {
+		die "error: cannot estimate sizes of partition '$partname', layout needs exactly one rom and one ram section\n";
+	}
+
+	return @sizes;
+}
+
+# Read bytes from the load image of an ELF file by load address
+# Usage: my $buffer = elf_read_lma('file.elf', $addr, $size);
+sub elf_read_lma
+{
+	my ($filename, $addr, $size) = @_;
+	my $FILE;
+	my $elf;
+
+	open($FILE, "<$filename") or die "Couldn't open $filename file for reading, $!\n";
+	binmode($FILE);
+	my $filesize = -s $filename;
+	if (sysread($FILE, $elf, $filesize) != $filesize) {
+		die "Couldn't read $filename properly, $!\n";
+	}
+	close($FILE) or die "Couldn't close $filename, $!\n";
+
+	if (substr($elf, 0, 4) ne "\x7fELF" || ord(substr($elf, 4, 1)) != 1) {
+		die "error: $filename is not a 32-bit ELF file\n";
+	}
+	my $w = (ord(substr($elf, 5, 1)) == 2) ? 'N' : 'V';
+	my $h = (ord(substr($elf, 5, 1)) == 2) ? 'n' : 'v';
+	my $phoff = unpack($w, substr($elf, 28, 4));
+	my $phentsize = unpack($h, substr($elf, 42, 2));
+	my $phnum = unpack($h, substr($elf, 44, 2));
+
+	# PT_LOAD segments by physical address, zero filled behind p_filesz
+	for (my $i = 0; $i < $phnum; $i++) {
+		my ($type, $offset, $vaddr, $paddr, $filesz, $memsz) =
+			unpack($w x 6, substr($elf, $phoff + $i * $phentsize, 24));
+
+		if ($type == 1 && $addr >= $paddr && $addr + $size <= $paddr + $memsz) {
+			my $buffer = '';
+			if ($addr - $paddr < $filesz) {
+				$buffer = substr($elf, $offset + $addr - $paddr, $filesz - ($addr - $paddr));
+			}
+			$buffer = substr($buffer . chr(0) x $size, 0, $size);
+			return $buffer;
+		}
+	}
+
+	die "error: $filename has no load image at ", hexify($addr), "\n";
+}
+
+# Append length extension bytes of an LZ4 sequence
+sub lz4_len
+{
+	my $len = shift;
+	my $out = '';
+
+	while ($len >= 255) {
+		$out .= chr(255);
+		$len -= 255;
+	}
+	return $out . chr($len);
+}
+
+# Encode an LZ4 sequence: literals, followed by an optional match
+sub lz4_sequence
+{
+	my ($literals, $offset, $mlen) = @_;
+	my $lit = length($literals);
+	my $token = ($lit >= 15 ? 15 : $lit) << 4;
+	my $out;
+
+	if ($mlen > 0) {
+		$token |= ($mlen - 4 >= 15 ? 15 : $mlen - 4);
+	}
+	$out = chr($token);
+	if ($lit >= 15) {
+		$out .= lz4_len($lit - 15);
+	}
+	$out .= $literals;
+	if ($mlen > 0) {
+		$out .= pack('v', $offset);
+		if ($mlen - 4 >= 15) {
+			$out .= lz4_len($mlen - 4 - 15);
+		}
+	}
+	return $out;
+}
+
+# Compress a buffer in LZ4 block format (greedy, last match wins)
+# The last 5 bytes are always literals and no match starts in the last 12 bytes.
+sub lz4_compress
+{
+	my $in = shift;
+	my $len = length($in);
+	my $out = '';
+	my %last;
+	my $anchor = 0;
+	my $pos = 0;
+
+	while ($pos < $len - 12) {
+		my $key = substr($in, $pos, 4);
+		my $ref = $last{$key};
+		$last{$key} = $pos;
+		if (!defined $ref || $pos - $ref > 65535) {
+			$pos++;
+			next;
+		}
+
+		my $mlen = 4;
+		while (($pos + $mlen < $len - 5) &&
+		       (substr($in, $ref + $mlen, 1) eq substr($in, $pos + $mlen, 1))) {
+			$mlen++;
+		}
+
+		$out .= lz4_sequence(substr($in, $anchor, $pos - $anchor), $pos - $ref, $mlen);
+		$pos += $mlen;
+		$anchor = $pos;
+	}
+
+	return $out . lz4_sequence(substr($in, $anchor), 0, 0);
+}
+
+# Reduce the ROM section that ends with the .data load image to the size of
+# the compressed image written by ab_gen_romimage.pl -z, plus the safety margin
+# Usage: shrink_compressed_data($filename, $layout, $data, \@sizes);
+sub shrink_compressed_data {
+	my ($elf_file, $layout, $data, $sizes) = @_;
+
+	my %symhash = sym_readelf($nm, $elf_file);
+	my $rom = sym_eval(\%symhash, $data->{rom});
+	my $start = sym_eval(\%symhash, $data->{start});
+	my $size = sym_eval(\%symhash, $data->{end}) - $start;
+
+	if ($size < 16) {
+		return;
+	}
+
+	my $image = 16 + length(lz4_compress(elf_read_lma($elf_file, $rom, $size)));
+	my $packed = align8($image + int(($image * $slack + 99) / 100));
+	if ($packed >= $size) {
+		return;
+	}
+
+	# only a load image at the end of a ROM section can be packed
+	for my $memory (@{$layout->{section}}) {
+		if ($memory->{type} ne "rom" ||
+		    sym_eval(\%symhash, $memory->{end}) != $rom + $size) {
+			next;
+		}
+		for my $s (@{$sizes}) {
+			if ($s->[0] eq $memory->{name}) {
+				$s->[3] = $rom - sym_eval(\%symhash, $memory->{start}) + $packed;
+			}
+		}
+	}
+}
+
+# Check the sizes of the final ELF files against the final memory map,
+# returns the number of exceeded sections
+sub check_final_sizes {
+	my $sys = shift;
+	my $memxmlfile = shift;
+	my $appdir = shift;
+	my %sizehash;
+	my $exceeded = 0;
+
+	my $mem = XMLin($memxmlfile,
+					KeyAttr => { },
+					ForceArray => ['shm', 'part', 'rq'],
+					) or die "opening and parsing of '$memxmlfile' failed!\n";
+
+	for my $part (@{$mem->{part}}) {
+		for my $rq (@{$part->{rq}}) {
+			if (defined $rq->{size}) {
+				$sizehash{$part->{name}."::".$rq->{name}} = number $rq->{size};
+			}
+		}
+	}
+
+	for my $part (@{$sys->{partition}}) {
+		my $partname = $part->{name};
+		my $layout = $part->{layout}[0];
+		my $elf = $appdir . "/" . $layout->{final_elf};
+		my $cpu = 0;
+		if (defined $part->{cpu}) {
+			$cpu = number $part->{cpu};
+		}
+
+		for my $s (get_required_rom_and_ram_from_elf($elf, $layout, $cpu)) {
+			my ($name, $type, $cpu, $required_size) = @{$s};
+			my $reserved = $sizehash{$partname."::".$name};
+
+			if (!defined $reserved) {
+				die "error: memory map '$memxmlfile' lacks final size of '$partname' section '$name'\n";
+			}
+			if ($required_size > $reserved) {
+				print STDERR "partition '$partname' section '$name' needs ", hexify($required_size),
+				             ", but only ", hexify($reserved), " were reserved\n";
+				$exceeded++;
+			}
+		}
+	}
+
+	return $exceeded;
+}
+
 sub usage
 {
 	my $ret = shift;
@@ -196,13 +541,20 @@ sub usage
 
 	print "usage:\n";
 	print "  ab_gen_memory_xml.pl [-h|--help] [--version]\n";
-	print "                       -o <memory.xml>\n";
+	print "                       [-s <nm>] [-e <size> [-g <percent>]] [-z [-k]]\n";
+	print "                       -o <memory.xml> | -c <final_memory.xml>\n";
 	print "                       <system.xml>\n";
 	print "\n";
 	print "options:\n";
 	print "  -h|--help       print this help text and exit\n";
 	print "  --version       print version information and exit\n";
+	print "  -s <nm>         nm tool to read symbols of ELF files\n";
+	print "  -e <size>       estimate partition sizes from app.ro using this size tool\n";
+	print "  -g <percent>    safety margin of estimates and compressed sizes (default: 5)\n";
+	print "  -z              size of compressed .data images of partitions with <data> layout\n";
+	print "  -k              size of the compressed kernel .data image as well\n";
 	print "  -o <memory.xml> memory.xml to create\n";
+	print "  -c <final_memory.xml> check final ELF files against the memory map\n";
 	print "  -p <directory> path to application\n";
 	print "  <system.xml>    system description\n";
 
@@ -211,6 +563,7 @@ sub usage
 
 my $outfile;
 my $xmlfile;
+my $checkfile;
 my $appdir = '.';
 
 while (defined $ARGV[0]) {
@@ -227,6 +580,24 @@ while (defined $ARGV[0]) {
 	} elsif ($ARGV[0] eq '-s') {
 		shift;
 		$nm = shift;
+	} elsif ($ARGV[0] eq '-e') {
+		shift;
+		$size_tool = shift;
+	} elsif ($ARGV[0] eq '-g') {
+		shift;
+		$slack = shift;
+		if (!defined $slack || $slack !~ /^\d+$/) {
+			die "error: invalid safety margin\n";
+		}
+	} elsif ($ARGV[0] eq '-c') {
+		shift;
+		$checkfile = shift;
+	} elsif ($ARGV[0] eq '-z') {
+		shift;
+		$compress = 1;
+	} elsif ($ARGV[0] eq '-k') {
+		shift;
+		$compress_kernel = 1;
 	} elsif ($ARGV[0] eq '-p') {
 		shift;
 		$appdir = shift;
@@ -242,7 +613,7 @@ if (!defined $xmlfile) {
 	die "error: no xml-file specified\n";
 }
 
-if (!defined $outfile) {
+if (!defined $outfile && !defined $checkfile) {
 	die "error: no output file specified\n";
 }
 
@@ -254,7 +625,7 @@ my @shms;
 {
 	my $all = XMLin($xmlfile,
 					KeyAttr => { },
-					ForceArray => ['layout', 'section', 'partition', 'shm', 'shm_access', 'rq'],
+					ForceArray => ['layout', 'section', 'partition', 'shm', 'shm_access', 'rq', 'data'],
 					) or die "opening and parsing of '$xmlfile' failed!\n";
 
 	my $sys = $all->{system};
@@ -265,6 +636,15 @@ my @shms;
 	$ram_align = number $target->{ram_align};
 	$num_cpus = number $target->{cpus};
 
+	if (defined $checkfile) {
+		my $exceeded = check_final_sizes($sys, $checkfile, $appdir);
+		if ($exceeded > 0) {
+			print STDERR "error: $exceeded section(s) exceed their estimated sizes\n";
+			exit 2;
+		}
+		exit 0;
+	}
+
 	# analyse kernel binary to get the ROM and RAM sizes
 	{
 		my $partname = '__KERNEL__';
@@ -277,6 +657,10 @@ my @shms;
 			die "error: <section> not found in kernel's <layout> config.xml\n";
 		}
 		my @sizes = get_required_rom_and_ram_from_elf($elf, $layout, $cpu);
+		if ($compress && $compress_kernel) {
+			my %data = ( rom => '__rom_data_start', start => '__data_start', end => '__data_end' );
+			shrink_compressed_data($elf, $layout, \%data, \@sizes);
+		}
 
 		my @other_rqs;
 		# iterate <rq> in <kernel> partition
@@ -299,7 +683,7 @@ my @shms;
 				$x = number $rq->{exec};
 			}
 			if (defined $rq->{cached}) {
-				$c = number $rq->{cached};
+				$c = cache_policy($rq->{cached}, "kernel <rq> '$name'");
 			}
 
 			push @other_rqs, [ $name, $resource, $r, $w, $x, $c ];
@@ -321,7 +705,21 @@ my @shms;
 		if (!defined $layout->{section}) {
 			die "error: <section> not found in partition's '", $partname, "' <layout> config.xml\n";
 		}
-		my @sizes = get_required_rom_and_ram_from_elf($elf, $layout, $cpu);
+		my @sizes;
+		if (defined $size_tool) {
+			# relocatable object next to the dummy ELF, unless given explicitly
+			my $ro = $layout->{ro};
+			if (!defined $ro) {
+				$ro = $layout->{dummy_elf};
+				$ro =~ s/[^\/\\]*$/app.ro/;
+			}
+			@sizes = estimate_rom_and_ram_from_ro($appdir . "/" . $ro, $layout, $cpu, $partname);
+		} else {
+			@sizes = get_required_rom_and_ram_from_elf($elf, $layout, $cpu);
+			if ($compress && defined $layout->{data}) {
+				shrink_compressed_data($elf, $layout, $layout->{data}[0], \@sizes);
+			}
+		}
 
 		my @other_rqs;
 		# iterate <rq> in partition
@@ -344,7 +742,7 @@ my @shms;
 				$x = number $rq->{exec};
 			}
 			if (defined $rq->{cached}) {
-				$c = number $rq->{cached};
+				$c = cache_policy($rq->{cached}, "partition '$partname' <rq> '$name'");
 			}
 
 			push @other_rqs, [ $name, $resource, $r, $w, $x, $c ];
@@ -368,7 +766,7 @@ my @shms;
 				$x = number $rq->{exec};
 			}
 			if (defined $rq->{cached}) {
-				$c = number $rq->{cached};
+				$c = cache_policy($rq->{cached}, "partition '$partname' <shm_access> '$s'");
 			}
 
 			push @other_rqs, [ $s, $s, $r, $w, $x, $c ];
@@ -387,6 +785,10 @@ my @shms;
 		if (!defined $cpu) {
 			$cpu = 0;
 		}
+		my $c = "";
+		if (defined $shm->{cached}) {
+			$c = cache_policy($shm->{cached}, "<shm> '$name'");
+		}
 		my $res;
 		my $align;
 
@@ -400,7 +802,7 @@ my @shms;
 			die "shm '$name' invalid type '$type', must be 'RAM' or 'ROM'\n";
 		}
 
-		push @shms, [ $name, $res, $size, $align, $desc ];
+		push @shms, [ $name, $res, $size, $align, $desc, $c ];
 	}
 }
 
@@ -413,11 +815,14 @@ print $OUTFILE "<!-- ", $VERSION, " -->\n";
 print $OUTFILE "<memory_layout mpu_arch=\"", $mpu_arch, "\">\n";
 
 foreach (@shms) {
-	my ($name, $res, $size, $align, $desc) = @{$_};
+	my ($name, $res, $size, $align, $desc, $c) = @{$_};
 
 	print $OUTFILE "\t<shm name=\"". $name ."\" resource=\"" . $res . "\"";
 	print $OUTFILE " minsize=\"" . hexify($size). "\"";
 	print $OUTFILE " align=\"" . hexify($align). "\"";
+	if ($c ne "") {
+		print $OUTFILE " cached=\"".$c."\"";
+	}
 	print $OUTFILE " description=\"" . $desc . "\"";
 	print $OUTFILE "/>\n";
 }
@@ -55,6 +55,143 @@ sub ilog {
 	return int((log shift) / log(2));
 }
 
+# ARM small page (4K) descriptor bits of a window, returns (bits, cachemode)
+sub pte_bits
+{
+	my $w = shift;
+
+	# ARM page table bits
+	# PTE_XN		0x001	/* execute never */
+	# PTE_P			0x002	/* present, type: 4K page */
+	# PTE_B			0x004	/* buffered */
+	# PTE_C			0x008	/* cached */
+	# PTE_AP0		0x010	/* AP0 */
+	# PTE_AP1		0x020	/* AP1 */
+	# PTE_TEX0		0x040	/* TEX0 */
+	# PTE_TEX1		0x080	/* TEX1 */
+	# PTE_TEX2		0x100	/* TEX2 */
+	# PTE_AP2		0x200	/* AP2 */
+	# PTE_S			0x400	/* shareable */
+	# PTE_NG		0x800	/* non global */
+	my $bits = 0x002;	# PTE_P
+
+	# Memory protection (user+rwx)
+	#
+	# AP 2..0 values
+	#     kernel   user usage
+	#  000  --      --
+	#  001  rw      --  kernel RW
+	#  010  rw      ro
+	#  011  rw      rw  user RW
+	#  100  ??      ??
+	#  101  ro      --  kernel R-
+	#  110  ro      --
+	#  111  ro      ro  user R-
+	$bits |= 0x010;	# PTE_AP0
+	if ($w->{user}) {
+		$bits |= 0x020;	# PTE_AP1
+	}
+	if (!$w->{write}) {
+		$bits |= 0x200;	# PTE_AP2
+	}
+	if (!$w->{exec}) {
+		$bits |= 0x001;	# PTE_XN
+	}
+
+	# Cache mode
+	#
+	# TEX C B  memory type           shareable
+	# 000 0 0  UC, strongly ordered  shareable
+	# 000 0 1  UC, device            shareable
+	# 000 1 0  WT, normal            S
+	# 000 1 1  WB, normal            S
+	# 001 0 0  UC, normal            S
+	# 001 1 1  WBWA, normal          S
+	# 010 0 0  non-shared device     not shareable
+
+	# Cortex-A8 is always a single core, assume: all others are SMP cores
+	my $smp = $mpu_arch !~ /arm_cortexa8/;
+	my $cachemode = "";
+	if ($w->{cached} == 1) {
+		if (!$smp) {
+			# Cortex-A8 does not support WBWA
+			$cachemode = "WB unshared";
+			$bits |= 0x008|0x004;	# PTE_C | PTE_B
+		} else {
+			$cachemode = "WBWA shareable";
+			$bits |= 0x040|0x008|0x004|0x400;	# PTE_TEX0 | PTE_C | PTE_B | PTE_S
+		}
+	} elsif ($w->{cached} == 2) {
+		$cachemode = "WT";
+		$bits |= 0x008;	# PTE_C
+		if ($smp) {
+			$cachemode .= " shareable";
+			$bits |= 0x400;	# PTE_S
+		}
+	} elsif ($w->{cached} == 3) {
+		$cachemode = "UC normal";
+		$bits |= 0x040;	# PTE_TEX0
+		if ($smp) {
+			$cachemode .= " shareable";
+			$bits |= 0x400;	# PTE_S
+		}
+	} elsif ($w->{cached} == 4) {
+		$cachemode = "UC device";
+		$bits |= 0x004;	# PTE_B
+	} else {
+		$cachemode = "UC strongly ordered";
+	}
+
+	return ($bits, $cachemode);
+}
+
+# convert small page bits to a large page (64K) descriptor:
+# XN moves to bit 15, TEX moves to bits 14..12, type is 0x1
+sub pte_large
+{
+	my $bits = shift;
+	my $large = 0x001;
+
+	$large |= $bits & 0xe3c;				# B, C, AP0, AP1, AP2, S, NG
+	$large |= (($bits >> 6) & 0x7) << 12;	# TEX
+	$large |= ($bits & 0x001) << 15;		# XN
+
+	return $large;
+}
+
+# convert small page bits to a section (1M) descriptor in domain 0:
+# type is 0x2, XN moves to bit 4, AP0/AP1 to bits 11..10, TEX to bits 14..12,
+# AP2 to bit 15, S to bit 16, NG to bit 17
+sub pte_section
+{
+	my $bits = shift;
+	my $sect = 0x002;
+
+	$sect |= $bits & 0x00c;					# B, C
+	$sect |= ($bits & 0x001) << 4;			# XN
+	$sect |= (($bits >> 4) & 0x3) << 10;	# AP0, AP1
+	$sect |= (($bits >> 6) & 0x7) << 12;	# TEX
+	$sect |= (($bits >> 9) & 0x1) << 15;	# AP2
+	$sect |= (($bits >> 10) & 0x1) << 16;	# S
+	$sect |= (($bits >> 11) & 0x1) << 17;	# NG
+
+	return $sect;
+}
+
+# check if $num pages starting at page index $first are all mapped with the same bits
+sub same_bits
+{
+	my ($pages, $first, $num) = @_;
+	my $w = $pages->{$first};
+
+	return 0 if (!defined $w);
+	for (my $i = $first + 1; $i < $first + $num; $i++) {
+		my $o = $pages->{$i};
+		return 0 if (!defined $o || $o->{bits} != $w->{bits});
+	}
+	return 1;
+}
+
 # print an MPU window in $ARCH-specific format
 # with level:
 # 0 -> kern
@@ -71,7 +208,7 @@ sub print_mpu_window
 	my $r = !!$window->{read}+0;
 	my $w = !!$window->{write}+0;
 	my $x = !!$window->{exec}+0;
-	my $c = !!$window->{cached}+0;
+	my $c = number $window->{cached};
 	my $arch = number $window->{arch};
 
 	print $CFGFILE "\t\t\t/* start: ", hexify($start), ", size: ", hexify($size);
@@ -80,6 +217,7 @@ sub print_mpu_window
 	if ($mpu_arch =~ /arm_cortexr4/) {
 		my $bas = $start;
 		my $siz = (ilog($size)-1 << 1) | 1;
+		$siz |= ($arch & 0xff) << 8;	# subregion disable bits
 		my $acc = !$x << 12;	# XN bit
 		if ($level == 0) {
 			# kernel window: user has no access
@@ -98,9 +236,18 @@ sub print_mpu_window
 		}
 
 		# cache attributes
-		if ($c) {
+		if ($c == 1) {
 			# FIXME: hardcoded: WBWA caching, non-shared
 			$acc |= 0xb;	# TEX S CB = 001 0 11
+		} elsif ($c == 2) {
+			# WT caching, non-shared
+			$acc |= 0x2;	# TEX S CB = 000 0 10
+		} elsif ($c == 3) {
+			# uncached normal memory, non-shared
+			$acc |= 0x8;	# TEX S CB = 001 0 00
+		} elsif ($c == 4) {
+			# device, shareable
+			$acc |= 0x1;	# TEX S CB = 000 0 01
 		} else {
 			# uncached, strongly ordered
 			$acc |= 0x0;	# TEX S CB = 000 0 00
@@ -117,6 +264,7 @@ sub print_mpu_window
 	} elsif ($mpu_arch =~ /arm_cortexm/) {
 		my $bas = $start;
 		my $siz = (ilog($size)-1 << 1) | 1;
+		$siz |= ($arch & 0xff) << 8;	# subregion disable bits
 		my $acc = !$x << 28;	# XN bit
 		# user window: supervisor has same access than user
 		if ($w) {
@@ -139,6 +287,21 @@ sub print_mpu_window
 			$acc |= 0x5 << 16;	# TEX S CB = 000 1 01
 		}
 
+		# explicit cache policies override the defaults above
+		if ($c == 2) {
+			# WT caching
+			$acc &= ~(0x3f << 16);
+			$acc |= 0x6 << 16;	# TEX S CB = 000 1 10
+		} elsif ($c == 3) {
+			# uncached normal memory
+			$acc &= ~(0x3f << 16);
+			$acc |= 0xc << 16;	# TEX S CB = 001 1 00
+		} elsif ($c == 4) {
+			# device
+			$acc &= ~(0x3f << 16);
+			$acc |= 0x5 << 16;	# TEX S CB = 000 1 01
+		}
+
 		if ($level == 2) {
 			# task window has ID 7, we only have 8 windows
 			$id = 7;
@@ -163,9 +326,18 @@ sub print_mpu_window
 		}
 
 		# cache attributes
-		if ($c) {
+		if ($c == 1) {
 			# hardcoded: WB caching, no memory coherency, big-endian
 			$mas2 |= 0x00;
+		} elsif ($c == 2) {
+			# WIMGE == 10000 (WT caching)
+			$mas2 |= 0x10;
+		} elsif ($c == 3) {
+			# WIMGE == 01000 (uncached, not guarded)
+			$mas2 |= 0x08;
+		} elsif ($c == 4) {
+			# WIMGE == 01010 (uncached, guarded)
+			$mas2 |= 0x0a;
 		} else {
 			# WIMGE == 01110 (uncached)
 			$mas2 |= 0x0e;
@@ -364,7 +536,7 @@ if ($gen_pagetables) {
 				my $r = !!$window->{read}+0;
 				my $w = !!$window->{write}+0;
 				my $x = !!$window->{exec}+0;
-				my $c = !!$window->{cached}+0;
+				my $c = number $window->{cached};
 				my $arch = number $window->{arch};
 
 				# NOTE: sometimes, SHMs are not properly aligned ...
@@ -382,152 +554,107 @@ if ($gen_pagetables) {
 		# sort by start address, ascending
 		my @wss = sort { $a->{start} <=> $b->{start} } @ws;
 
-		# the following algorithm scans linearly thru the address space
-		# and creates page tables for all windows it finds.
-		# it does this in two passes: the first pass generates all 2nd level
-		# page tables, then generates the first level page table.
-		# the page tables are kept in @pts and are referenced by their address
-		my $addr = 0;
-		my $pos;
-		my $level = 1;
-		my @pts;
+		# assign each 4K page to the first window covering it
+		my %pages;
 		for my $w (@wss) {
-			my $start = $w->{start};
-			my $size = $w->{size};
-			# ARM page table bits
-			# PTE_XN		0x001	/* execute never */
-			# PTE_P			0x002	/* present, type: 4K page */
-			# PTE_B			0x004	/* buffered */
-			# PTE_C			0x008	/* cached */
-			# PTE_AP0		0x010	/* AP0 */
-			# PTE_AP1		0x020	/* AP1 */
-			# PTE_TEX0		0x040	/* TEX0 */
-			# PTE_TEX1		0x080	/* TEX1 */
-			# PTE_TEX2		0x100	/* TEX2 */
-			# PTE_AP2		0x200	/* AP2 */
-			# PTE_S			0x400	/* shareable */
-			# PTE_NG		0x800	/* non global */
-			my $bits = 0x002;	# PTE_P
-
-			# Memory protection (user+rwx)
-			#
-			# AP 2..0 values
-			#     kernel   user usage
-			#  000  --      --
-			#  001  rw      --  kernel RW
-			#  010  rw      ro
-			#  011  rw      rw  user RW
-			#  100  ??      ??
-			#  101  ro      --  kernel R-
-			#  110  ro      --
-			#  111  ro      ro  user R-
-			$bits |= 0x010;	# PTE_AP0
-			if ($w->{user}) {
-				$bits |= 0x020;	# PTE_AP1
-			}
-			if (!$w->{write}) {
-				$bits |= 0x200;	# PTE_AP2
-			}
-			if (!$w->{exec}) {
-				$bits |= 0x001;	# PTE_XN
-			}
-
-			# Cache mode
-			#
-			# TEX C B  memory type           shareable
-			# 000 0 0  UC, strongly ordered  shareable
-			# 000 0 1  UC, device            shareable
-			# 000 1 0  WT, normal            S
-			# 000 1 1  WB, normal            S
-			# 001 0 0  UC, normal            S
-			# 001 1 1  WBWA, normal          S
-			# 010 0 0  non-shared device     not shareable
-
-			my $cachemode = "";
-			if ($w->{cached}) {
-				if ($mpu_arch =~ /arm_cortexa8/) {
-					# Cortex-A8 is always a single core and does not support WBWA
-					$cachemode = "WB unshared";
-					$bits |= 0x008|0x004;	# PTE_C | PTE_B
-				} else {
-					# Assume: all others are SMP cores
-					$cachemode = "WBWA shareable";
-					$bits |= 0x040|0x008|0x004|0x400;	# PTE_TEX0 | PTE_C | PTE_B | PTE_S
+			my ($bits, $cachemode) = pte_bits($w);
+			$w->{bits} = $bits;
+			$w->{desc} = ($w->{user}?'u':'-') . ($w->{read}?'r':'-') .
+			             ($w->{write}?'w':'-') . ($w->{exec}?'x':'-') .
+			             " " . $cachemode;
+
+			for (my $addr = $w->{start}; $addr < $w->{start} + $w->{size}; $addr += 0x1000) {
+				if (!defined $pages{$addr >> 12}) {
+					$pages{$addr >> 12} = $w;
 				}
-			} else {
-				$cachemode = "UC strongly ordered";
 			}
+		}
 
-			#print "HERE, addr:", hexify($addr), ", s:", hexify($start), ", s:", hexify($size), ", $level\n";
-
-			if ($level > 1) {
-				# fill up currently open page table with invalid entries
-				while ($addr < $start && $pos < 256) {
-					print $CFGFILE "\t/* ", hexify($addr)," */\t0,\n";
-					$addr += 0x1000;	# 4K
-					$pos++;
-				}
-				if ($pos == 256) {
-					print $CFGFILE "};\n\n";
-					$level = 1;
-				}
-			}
-			if ($level == 1) {
-				die if ($addr & 0xfffff) != 0;
-				while ($addr < ($start & 0xfff00000)) {
-					$addr += 0x100000;	# 1M
-				}
-			}
-			if ($level == 1 && ($addr & 0xfffff) == 0) {
-				# open new page table
-				print $CFGFILE "const uint32_t _pt2_part", $part_id, "_", hexify($addr),"[256] __section_cfg_pt2 __aligned(1024) = {\n";
-				push @pts, { start => $addr };
-				$pos = 0;
-				$level = 2;
-				$num_pt2_tables++;
+		# the following algorithm scans thru the address space in 1M steps.
+		# A 1M slot with the same attributes for all pages becomes a section
+		# in the first level page table. Otherwise, the slot gets a 2nd level
+		# page table with 64K large pages where 16 aligned pages share the
+		# same attributes, and 4K small pages at the edges.
+		# The 2nd level page tables are emitted first and are referenced
+		# by their address in the first level page table.
+		my %slots;
+		for my $page (keys %pages) {
+			$slots{$page >> 8} = 1;
+		}
+		my %l1;
+		my $num_sections = 0;
+		my $num_large = 0;
+		my $num_small = 0;
+		my $num_tables = 0;
+		for my $slot (sort { $a <=> $b } keys %slots) {
+			my $base = $slot << 20;
+
+			if (same_bits(\%pages, $slot << 8, 256)) {
+				my $w = $pages{$slot << 8};
+				$l1{$slot} = hexify($base) . " | " . sprintf("0x%05x", pte_section($w->{bits})) .
+				             ", /* " . $w->{desc} . ", 1M section */";
+				$num_sections++;
+				next;
 			}
-			die if ($level == 1);
 
-			# fill with meaning-ful entries
-			if ($addr < $start) {
-				redo;
-			}
+			print $CFGFILE "const uint32_t _pt2_part", $part_id, "_", hexify($base),"[256] __section_cfg_pt2 __aligned(1024) = {\n";
+			for (my $i = 0; $i < 256; $i += 16) {
+				my $large = same_bits(\%pages, ($slot << 8) + $i, 16);
+				if ($large) {
+					$num_large++;
+				}
 
-			while ($addr < ($start + $size) && $pos < 256) {
-				print $CFGFILE "\t/* ", hexify($addr)," */\t", hexify($addr);
-				print $CFGFILE " | ", sprintf("0x%03x", $bits), ", /* ";
-				print $CFGFILE $w->{user}?'u':'-';
-				print $CFGFILE $w->{read}?'r':'-';
-				print $CFGFILE $w->{write}?'w':'-';
-				print $CFGFILE $w->{exec}?'x':'-';
-				print $CFGFILE " ", $cachemode, " */\n";
-				$addr += 0x1000;	# 4K
-				$pos++;
-			}
-			if ($pos == 256) {
-				redo;
+				for (my $j = $i; $j < $i + 16; $j++) {
+					my $addr = $base + ($j << 12);
+					my $w = $pages{($slot << 8) + $j};
+					if (!defined $w) {
+						print $CFGFILE "\t/* ", hexify($addr)," */\t0,\n";
+					} elsif ($large) {
+						# all 16 entries of a large page are identical
+						print $CFGFILE "\t/* ", hexify($addr)," */\t", hexify($base + ($i << 12));
+						print $CFGFILE " | ", sprintf("0x%04x", pte_large($w->{bits})), ", /* ";
+						print $CFGFILE $w->{desc}, ", 64K */\n";
+					} else {
+						print $CFGFILE "\t/* ", hexify($addr)," */\t", hexify($addr);
+						print $CFGFILE " | ", sprintf("0x%03x", $w->{bits}), ", /* ";
+						print $CFGFILE $w->{desc}, " */\n";
+						$num_small++;
+					}
+				}
 			}
-		}
-		# close last open page table
-		if ($level > 1) {
 			print $CFGFILE "};\n\n";
+
+			# NOTE: cannot use "|" in relocs, must use "+" to concat address and page table bits!
+			$l1{$slot} = "(uint32_t)_pt2_part" . $part_id . "_" . hexify($base) . " + 0x1,";
+			$num_pt2_tables++;
+			$num_tables++;
 		}
 
 		# now emit 1st level page table
-		my @ptss = sort { $a->{start} <=> $b->{start} } @pts;
-		$addr = 0;
+		my $slot = 0;
 		print $CFGFILE "const uint32_t _pt1_part", $part_id, "[4096] __section_cfg_pt1 __aligned(16384) = {\n";
-		for my $p (@ptss) {
-			my $start = $p->{start};
-			while ($addr < $start) {
-				print $CFGFILE "\t/* ", hexify($addr)," */\t0,\n";
-				$addr += 0x100000;	# 1M
+		for my $s (sort { $a <=> $b } keys %l1) {
+			while ($slot < $s) {
+				print $CFGFILE "\t/* ", hexify($slot << 20)," */\t0,\n";
+				$slot++;
 			}
-			# NOTE: cannot use "|" in relocs, must use "+" to concat address and page table bits!
-			print $CFGFILE "\t/* ", hexify($addr)," */\t(uint32_t)_pt2_part", $part_id, "_", hexify($addr), " + 0x1,\n";
-			$addr += 0x100000;	# 1M
+			print $CFGFILE "\t/* ", hexify($slot << 20)," */\t", $l1{$s}, "\n";
+			$slot++;
 		}
 		print $CFGFILE "};\n\n";
+
+		# TLB usage report
+		my $num_entries = $num_sections + $num_large + $num_small;
+		print $CFGFILE "/* partition '", $part->{name}, "': ", $num_sections, " 1M sections, ",
+		               $num_large, " 64K pages, ", $num_small, " 4K pages, ",
+		               $num_tables, " 2nd level tables */\n";
+		print $CFGFILE "/* partition '", $part->{name}, "': ", $num_entries, " TLB entries (",
+		               scalar(keys %pages), " with 4K pages only) */\n\n";
+		if ($final_run) {
+			printf "partition '%s': %d TLB entries (%d sections, %d large pages, %d small pages), %d with 4K pages only\n",
+			       $part->{name}, $num_entries, $num_sections, $num_large, $num_small, scalar(keys %pages);
+		}
+
 		$part_id++;
 	}
 
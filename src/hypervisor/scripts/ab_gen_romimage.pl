@@ -8,12 +8,20 @@
 # Usage: ab_gen_romimage.pl -m memory.xml system.xml -o binary.bin
 # Without the memory map, this script assumes dummy addresses for RAM and ROM.
 #
+# With -z, the .data load images of partitions with a <data> layout element
+# are replaced by LZ4 compressed images, see kernel/include/lz4.h.
+# With -k, the kernel's .data load image is compressed as well.
+# A compressed image at the end of a binary is packed: the binary ends with it.
+# The ROM sizes in the memory map must account for this, see the -z option
+# of ab_gen_memory_xml.pl.
+#
 # azuepke, 2014-08-19: initial
 
 
 use strict;
 use warnings "all";
 use XML::Simple;
+use IPC::Open2;
 use Data::Dumper;
 
 # tool version ID
@@ -22,13 +30,118 @@ my $VERSION = "ab_gen_romimage.pl 2015-06-26";
 # global variables
 my $verbose = 0;
 my %addrhash;
+my %sizehash;
 my $orig_rom_base;
 my @chunks;
 my $chunk;
+my $nm = 'nm';
+my $compress = 0;
+my $compress_kernel = 0;
 
 
 ################################################################################
 
+# Read symbols from ELF file (uses "nm" internally)
+# Usage: my %symhash = sym_readelf('/path/to/nm', 'file.elf');
+sub sym_readelf
+{
+	my @inputstream;
+	my %h;
+
+	# get all symbols
+	open2(\*INPUTSTREAM, undef, $_[0], '--extern-only', '--defined-only', '--print-size', $_[1]);
+	@inputstream = <INPUTSTREAM>;
+	close INPUTSTREAM;
+
+	# filter and prepare
+	foreach (@inputstream) {
+		chomp $_;
+		my @l = split(/\s/, $_);
+		my $n;
+		my $a;
+		my $s;
+		if (scalar(@l) == 4) {
+			$n = $l[3];
+			$a = hex $l[0];
+			$s = hex $l[1];
+		} else {
+			# object has no known size, assume 0
+			$n = $l[2];
+			$a = hex $l[0];
+			$s = 0;
+		}
+		#print $n, ": ", $a, " sz ",  $s, "\n";
+		@l = ($a, $s);
+		$h{$n} = \@l;
+	}
+
+	return %h;
+}
+
+# Evaluate symbol expression
+# Usage: my $addr = sym_eval(\%symhash, $expression);
+# NOTE: the parser evaluates expressions from left to right in a single pass
+#   printf                  <- address of printf
+#   main + 0x1000 + 48      <- address of main + 4144 bytes
+#   /stack - 16             <- end of stack - 16 bytes
+#   0x12345                 <- const address 0x12345
+# NOTE: spaces are required between the sub-expressions!
+sub sym_eval
+{
+	my $href = shift;
+	my $expr = shift;
+	my $result = 0;
+	my $neg = 1;
+	my @s;
+
+	if (!defined $expr) {
+		die "error: unnamed symbol, assuming 0\n";
+		return 0;
+	}
+
+	my @l = split(/\s/, $expr);
+	foreach (@l) {
+		if (substr ($_, 0, 1) eq '/') {
+			# /symbol
+			$_ = substr ($_, 1);
+			if (!defined $href->{$_}) {
+				die "error: undefined symbol '", $_, "', assuming 0\n";
+				return 0;
+			}
+			@s = $href->{$_};
+			#print "sz: ", $s[0][0], ", ", $s[0][1], "\n";
+			$result += $neg * ($s[0][0] + $s[0][1]);
+			$neg = 1;
+		} elsif ($_ eq '+') {
+			# plus
+			$neg = 1;
+		} elsif ($_ eq '-') {
+			# minus
+			$neg = -1;
+		} elsif (substr ($_, 0, 2) eq '0x') {
+			# hex digits
+			$result += $neg * hex($_);
+			$neg = 1;
+		} elsif (/^\d/) {
+			# dec digits
+			$result += $neg * int($_);
+			$neg = 1;
+		} else {
+			# symbol
+			if (!defined $href->{$_}) {
+				die "error: undefined symbol '", $_, "', assuming 0\n";
+				return 0;
+			}
+			@s = $href->{$_};
+			#print "sz: ", $s[0][0], ", ", $s[0][1], "\n";
+			$result += $neg * $s[0][0];
+			$neg = 1;
+		}
+	}
+
+	return $result;
+}
+
 # Evaluate hex or decimal number
 sub number
 {
@@ -71,6 +184,123 @@ sub readbin
 
 ################################################################################
 
+# Append length extension bytes of an LZ4 sequence
+sub lz4_len
+{
+	my $len = shift;
+	my $out = '';
+
+	while ($len >= 255) {
+		$out .= chr(255);
+		$len -= 255;
+	}
+	return $out . chr($len);
+}
+
+# Encode an LZ4 sequence: literals, followed by an optional match
+sub lz4_sequence
+{
+	my ($literals, $offset, $mlen) = @_;
+	my $lit = length($literals);
+	my $token = ($lit >= 15 ? 15 : $lit) << 4;
+	my $out;
+
+	if ($mlen > 0) {
+		$token |= ($mlen - 4 >= 15 ? 15 : $mlen - 4);
+	}
+	$out = chr($token);
+	if ($lit >= 15) {
+		$out .= lz4_len($lit - 15);
+	}
+	$out .= $literals;
+	if ($mlen > 0) {
+		$out .= pack('v', $offset);
+		if ($mlen - 4 >= 15) {
+			$out .= lz4_len($mlen - 4 - 15);
+		}
+	}
+	return $out;
+}
+
+# Compress a buffer in LZ4 block format (greedy, last match wins)
+# The last 5 bytes are always literals and no match starts in the last 12 bytes.
+sub lz4_compress
+{
+	my $in = shift;
+	my $len = length($in);
+	my $out = '';
+	my %last;
+	my $anchor = 0;
+	my $pos = 0;
+
+	while ($pos < $len - 12) {
+		my $key = substr($in, $pos, 4);
+		my $ref = $last{$key};
+		$last{$key} = $pos;
+		if (!defined $ref || $pos - $ref > 65535) {
+			$pos++;
+			next;
+		}
+
+		my $mlen = 4;
+		while (($pos + $mlen < $len - 5) &&
+		       (substr($in, $ref + $mlen, 1) eq substr($in, $pos + $mlen, 1))) {
+			$mlen++;
+		}
+
+		$out .= lz4_sequence(substr($in, $anchor, $pos - $anchor), $pos - $ref, $mlen);
+		$pos += $mlen;
+		$anchor = $pos;
+	}
+
+	return $out . lz4_sequence(substr($in, $anchor), 0, 0);
+}
+
+# Replace the .data load image in a ROM tuple with a compressed image, if it shrinks
+# Usage: compress_data($tuple, "name", $offset_in_file, $size, $reserved_rom_size);
+sub compress_data
+{
+	my ($tuple, $name, $offset, $size, $reserved) = @_;
+
+	if ($offset < 0 || $offset + $size > $tuple->[1]) {
+		die "error: .data image of $name not in binary\n";
+	}
+
+	my $data = substr($tuple->[2], $offset, $size);
+	if (substr($data, 0, 4) eq "LZ4D") {
+		die "error: .data image of $name looks like a compressed image\n";
+	}
+	if ($size < 16) {
+		return;
+	}
+
+	my $comp = lz4_compress($data);
+	my $image = "LZ4D" . pack('VVV', length($comp), $size, 0) . $comp;
+	if (length($image) >= $size) {
+		if ($verbose) {
+			print "partition: $name: .data not compressed, $size bytes\n";
+		}
+		return;
+	}
+
+	print "partition: $name: .data compressed from $size to ", length($image), " bytes (",
+	      int(length($image) * 100 / $size), "%)\n";
+	if ($offset + $size == $tuple->[1]) {
+		# pack: the binary ends with the compressed image
+		$tuple->[2] = substr($tuple->[2], 0, $offset) . $image;
+		$tuple->[1] = $offset + length($image);
+		if ($tuple->[1] > $reserved) {
+			die "error: $name needs ", hexify($tuple->[1]), " bytes of ROM, but only ",
+			    hexify($reserved), " were reserved, increase LAYOUT_MARGIN\n";
+		}
+	} else {
+		$image .= chr(0) x ($size - length($image));
+		substr($tuple->[2], $offset, $size) = $image;
+	}
+}
+
+################################################################################
+
 sub usage
 {
 	my $ret = shift;
@@ -84,6 +314,7 @@ sub usage
 	print "                     -m <memory.xml>\n";
 	print "                     <system.xml>\n";
 	print "                     -o <image.bin>\n";
+	print "                     [-z [-k]] [-s <nm>]\n";
 	print "\n";
 	print "options:\n";
 	print "  -h|--help       print this help text and exit\n";
@@ -92,6 +323,9 @@ sub usage
 	print "  -m <memory.xml> memory map description (for memory layout)\n";
 	print "  <system.xml>    system description (for partition layout)\n";
 	print "  -o <image.bin>  binary ROM image to create\n";
+	print "  -z              compress .data images of partitions with <data> layout\n";
+	print "  -k              compress the kernel's .data image as well\n";
+	print "  -s <nm>         name of nm tool (default: nm)\n";
 
 	exit $ret;
 }
@@ -123,6 +357,15 @@ while (defined $ARGV[0]) {
 	} elsif ($ARGV[0] eq '-p') {
 		shift;
 		$appdir = shift;
+	} elsif ($ARGV[0] eq '-z') {
+		shift;
+		$compress = 1;
+	} elsif ($ARGV[0] eq '-k') {
+		shift;
+		$compress_kernel = 1;
+	} elsif ($ARGV[0] eq '-s') {
+		shift;
+		$nm = shift;
 	} else {
 		if (defined $sysxmlfile) {
 			die "error: invalid argument '", $ARGV[0], "'\n";
@@ -154,6 +397,7 @@ if (!defined $binfile) {
 	for my $part (@{$mem->{part}}) {
 		my $partname = $part->{name};
 		my $rom_base = -1;
+		my $rom_size = 0;
 
 		for my $rq (@{$part->{rq}}) {
 			if (!defined $rq->{start} || !defined $rq->{size}) {
@@ -162,6 +406,7 @@ if (!defined $binfile) {
 
 			if ($rq->{resource} eq "__ROM__") {
 				$rom_base = number $rq->{start};
+				$rom_size = number $rq->{size};
 			}
 		}
 		if ($rom_base == -1) {
@@ -172,6 +417,7 @@ if (!defined $binfile) {
 			print "partition: $partname -> ROM: ", hexify($rom_base), "\n";
 		}
 		$addrhash{$partname} = $rom_base;
+		$sizehash{$partname} = $rom_size;
 	}
 }
 
@@ -180,7 +426,7 @@ if (!defined $binfile) {
 	# Parse system description XML
 	my $all = XMLin($sysxmlfile,
 					KeyAttr => { },
-					ForceArray => ['layout', 'partition'],
+					ForceArray => ['layout', 'partition', 'data'],
 					) or die "opening and parsing of '$sysxmlfile' failed!\n";
 
 	my $sys = $all->{system};
@@ -207,6 +453,12 @@ if (!defined $binfile) {
 			print "partition: $partname: reading $bin\n";
 		}
 		my $chunk = readbin($bin, $rom_base - $orig_rom_base);
+		if ($compress && $compress_kernel) {
+			my %symhash = sym_readelf($nm, $target->{kernel}->{layout}[0]->{final_elf});
+			my $start = sym_eval(\%symhash, '__data_start');
+			compress_data($chunk, $partname, sym_eval(\%symhash, '__rom_data_start') - $rom_base,
+			              sym_eval(\%symhash, '__data_end') - $start, $sizehash{$partname});
+		}
 		push (@chunks, $chunk);
 	}
 
@@ -224,6 +476,13 @@ if (!defined $binfile) {
 			print "partition: $partname: reading $bin\n";
 		}
 		my $chunk = readbin($bin, $rom_base - $orig_rom_base);
+		my $data = $part->{layout}[0]->{data};
+		if ($compress && defined $data) {
+			my %symhash = sym_readelf($nm, $appdir . "/" . $part->{layout}[0]->{final_elf});
+			my $start = sym_eval(\%symhash, $data->[0]->{start});
+			compress_data($chunk, $partname, sym_eval(\%symhash, $data->[0]->{rom}) - $rom_base,
+			              sym_eval(\%symhash, $data->[0]->{end}) - $start, $sizehash{$partname});
+		}
 		push (@chunks, $chunk);
 	}
 }
@@ -0,0 +1,323 @@
+#!/usr/bin/perl -w
+#
+# ab_profile_decode.pl - symbolize kernel profiler samples
+#
+# The kernel must be built with PROFILE=yes. Dump the per-CPU sample buffers
+# from the target, e.g. with GDB:
+#
+#   (gdb) dump binary memory profile.bin &profile_buf ((char *)&profile_buf) + sizeof(profile_buf)
+#
+# and symbolize the samples against the symbol maps generated by the build
+# (kernel.map of the BSP and app.map of each partition):
+#
+#   ab_profile_decode.pl -c final_config.c -m bsp/qemu-arm/kernel.map \
+#                        -m ../demos/car/app1/app.map profile.bin
+#
+# Usage: ab_profile_decode.pl [-b] [-n <count>] [-c <config.c>] -m <file.map> ... <profile.bin> [-o <report.txt>]
+#
+# agent, 2026-10-18: initial
+
+
+use strict;
+use warnings "all";
+
+# tool version ID
+my $VERSION = "ab_profile_decode.pl 2026-10-18";
+
+# keep in sync with kernel/include/profile.h
+my $PROFILE_MAGIC = 0x50524631;
+my $PROFILE_HDR_SIZE = 16;
+my $PROFILE_SAMPLE_SIZE = 8;
+
+# global variables
+my $verbose = 0;
+my $bigendian = 0;
+my $top = 30;
+my @task_names;
+my @part_names;
+my @symbols;	# sorted list of [address, name, map]
+
+
+################################################################################
+
+# Read a file into a buffer
+sub readbin
+{
+	my $filename = shift;
+	my $buffer;
+	my $FILE;
+
+	open($FILE, "<$filename") or die "Couldn't open $filename file for reading, $!\n";
+	binmode($FILE);
+	my $filesize = -s $filename;
+	my $n = sysread($FILE, $buffer, $filesize);
+	if ($n != $filesize) {
+		die "Couldn't read $filename properly, $!\n";
+	}
+	close($FILE) or die "Couldn't close $filename, $!\n";
+
+	return $buffer;
+}
+
+# Extract task and partition names in global ID order from a generated config.c
+sub read_config_names
+{
+	my $filename = shift;
+	my $FILE;
+	my $list;
+
+	open($FILE, "<$filename") or die "Couldn't open $filename file for reading, $!\n";
+	while (<$FILE>) {
+		if (/^const struct task_cfg task_cfg\[/) {
+			$list = \@task_names;
+		} elsif (/^const struct part_cfg part_cfg\[/) {
+			$list = \@part_names;
+		} elsif (defined $list && /^};/) {
+			undef $list;
+		} elsif (defined $list && /^\t\t\.name = "(.*)"/) {
+			push(@$list, $1);
+		}
+	}
+	close($FILE) or die "Couldn't close $filename, $!\n";
+}
+
+# Read code symbols from a map file (output of "nm -n")
+sub read_map
+{
+	my $filename = shift;
+	my $FILE;
+	my $map = $filename;
+	my $n = 0;
+
+	$map =~ s/.*[\/\\]//;
+	if ($filename =~ /([^\/\\]+)[\/\\][^\/\\]+$/) {
+		# use the directory name to tell app.map files apart
+		$map = $1 . "/" . $map;
+	}
+
+	open($FILE, "<$filename") or die "Couldn't open $filename file for reading, $!\n";
+	while (<$FILE>) {
+		if (/^([0-9a-fA-F]+)\s+[TtWw]\s+(\S+)/) {
+			# skip ARM mapping symbols ($a, $t, $d)
+			next if ($2 =~ /^\$/);
+			push(@symbols, [hex($1), $2, $map]);
+			$n++;
+		}
+	}
+	close($FILE) or die "Couldn't close $filename, $!\n";
+
+	if ($verbose) {
+		print STDERR "$filename: $n code symbols\n";
+	}
+}
+
+# Find the symbol covering an address (binary search), returns index or -1
+sub lookup
+{
+	my $addr = shift;
+	my $lo = 0;
+	my $hi = @symbols - 1;
+	my $found = -1;
+
+	while ($lo <= $hi) {
+		my $mid = int(($lo + $hi) / 2);
+		if ($symbols[$mid][0] <= $addr) {
+			$found = $mid;
+			$lo = $mid + 1;
+		} else {
+			$hi = $mid - 1;
+		}
+	}
+	return $found;
+}
+
+# Return printable name for a global task ID
+sub task_name
+{
+	my $id = shift;
+	if (defined $task_names[$id]) {
+		return $task_names[$id];
+	}
+	return "task $id";
+}
+
+# Return printable name for a partition ID
+sub part_name
+{
+	my $id = shift;
+	if (defined $part_names[$id]) {
+		return $part_names[$id];
+	}
+	return "part $id";
+}
+
+################################################################################
+
+sub usage
+{
+	my $ret = shift;
+	if (!defined $ret) {
+		$ret = 1;
+	}
+
+	print "usage:\n";
+	print "  ab_profile_decode.pl [-h|--help] [--version]\n";
+	print "                       [-v] [-b] [-n <count>]\n";
+	print "                       [-c <config.c>]\n";
+	print "                       -m <file.map> [-m <file.map> ...]\n";
+	print "                       <profile.bin>\n";
+	print "                       [-o <report.txt>]\n";
+	print "\n";
+	print "options:\n";
+	print "  -h|--help        print this help text and exit\n";
+	print "  --version        print version information and exit\n";
+	print "  -v               verbosity level, increases for each -v\n";
+	print "  -b               sample dump is big endian\n";
+	print "  -n <count>       number of hot functions to list (default: 30)\n";
+	print "  -c <config.c>    generated kernel config (for task and partition names)\n";
+	print "  -m <file.map>    symbol map (nm -n output) of the kernel or an app\n";
+	print "  <profile.bin>    binary dump of the kernel's profile_buf[]\n";
+	print "  -o <report.txt>  report file to create (default: stdout)\n";
+
+	exit $ret;
+}
+
+################################################################################
+
+my $binfile;
+my $reportfile;
+
+while (defined $ARGV[0]) {
+	if ($ARGV[0] eq '--help') {
+		usage(0);
+	} elsif ($ARGV[0] eq '-h') {
+		usage(0);
+	} elsif ($ARGV[0] eq '--version') {
+		print "version: ", $VERSION, "\n";
+		exit 0;
+	} elsif ($ARGV[0] eq '-v') {
+		shift;
+		$verbose++;
+	} elsif ($ARGV[0] eq '-b') {
+		shift;
+		$bigendian = 1;
+	} elsif ($ARGV[0] eq '-n') {
+		shift;
+		$top = shift;
+		if (!defined $top || $top <= 0) {
+			die "error: invalid count\n";
+		}
+	} elsif ($ARGV[0] eq '-c') {
+		shift;
+		read_config_names(shift);
+	} elsif ($ARGV[0] eq '-m') {
+		shift;
+		read_map(shift);
+	} elsif ($ARGV[0] eq '-o') {
+		shift;
+		$reportfile = shift;
+	} else {
+		if (defined $binfile) {
+			die "error: invalid argument '", $ARGV[0], "'\n";
+		}
+		$binfile = shift;
+	}
+}
+
+if (!defined $binfile) {
+	die "error: no sample dump specified\n";
+}
+
+if (@symbols == 0) {
+	die "error: no symbol map specified\n";
+}
+@symbols = sort { $a->[0] <=> $b->[0] } @symbols;
+
+my $u32 = $bigendian ? "N" : "V";
+my $u16 = $bigendian ? "n" : "v";
+my $buffer = readbin($binfile);
+my $offset = 0;
+my $total = 0;
+my $period;
+my %func_hits;		# "part:symbol index" -> samples
+my %part_hits;		# part ID -> samples
+my %task_hits;		# global task ID -> samples
+
+# walk the per-CPU sample buffers
+while ($offset + $PROFILE_HDR_SIZE <= length($buffer)) {
+	my ($magic, $num_samples, $sample_size, $count, $buf_period) =
+		unpack("\@$offset $u32 $u16 $u16 $u32 $u32", $buffer);
+
+	if ($magic != $PROFILE_MAGIC) {
+		# unused or uninitialized buffer
+		last;
+	}
+	if ($sample_size != $PROFILE_SAMPLE_SIZE || $num_samples == 0) {
+		die "error: invalid sample buffer header at offset $offset\n";
+	}
+	$period = $buf_period;
+
+	my $samples = $offset + $PROFILE_HDR_SIZE;
+	my $n = $count;
+	if ($count > $num_samples) {
+		$n = $num_samples;
+	}
+	if ($verbose) {
+		print STDERR "buffer at offset $offset: $count samples recorded, $n available\n";
+	}
+
+	# the order of the samples doesn't matter
+	for (my $i = 0; $i < $n; $i++) {
+		my $pos = $samples + $i * $sample_size;
+		my ($pc, $task, $part, $cpu) =
+			unpack("\@$pos $u32 $u16 C C", $buffer);
+
+		$func_hits{$part . ":" . lookup($pc)}++;
+		$part_hits{$part}++;
+		$task_hits{$task}++;
+		$total++;
+	}
+
+	$offset = $samples + $num_samples * $sample_size;
+}
+
+if ($total == 0) {
+	die "error: no samples found in $binfile\n";
+}
+
+my $FILE;
+if (defined $reportfile) {
+	open $FILE, ">$reportfile" or die "Couldn't open $reportfile file for writing, $!\n";
+} else {
+	$FILE = *STDOUT;
+}
+
+printf $FILE "%d samples, one sample every %d events\n\n", $total, $period;
+
+print $FILE "samples     %  partition\n";
+for my $part (sort { $part_hits{$b} <=> $part_hits{$a} } keys %part_hits) {
+	printf $FILE "%7d %5.1f  %s\n", $part_hits{$part}, 100.0 * $part_hits{$part} / $total, part_name($part);
+}
+print $FILE "\n";
+
+print $FILE "samples     %  task\n";
+for my $task (sort { $task_hits{$b} <=> $task_hits{$a} } keys %task_hits) {
+	printf $FILE "%7d %5.1f  %s\n", $task_hits{$task}, 100.0 * $task_hits{$task} / $total, task_name($task);
+}
+print $FILE "\n";
+
+print $FILE "samples     %  partition         function\n";
+my $i = 0;
+for my $key (sort { $func_hits{$b} <=> $func_hits{$a} } keys %func_hits) {
+	last if ($i++ >= $top);
+	my ($part, $sym) = split(/:/, $key);
+	my $name = "[unknown]";
+	if ($sym >= 0) {
+		$name = $symbols[$sym][1] . " (" . $symbols[$sym][2] . ")";
+	}
+	printf $FILE "%7d %5.1f  %-16s  %s\n", $func_hits{$key}, 100.0 * $func_hits{$key} / $total, part_name($part), $name;
+}
+
+if (defined $reportfile) {
+	close($FILE) or die "Couldn't close $reportfile, $!\n";
+}
@@ -0,0 +1,491 @@
+#!/usr/bin/perl -w
+#
+# ab_sched_sim.pl - host-side time partition schedule validator and simulator
+#
+# NOTE: requires the XML::Simple CPAN module
+#       on Ubuntu 12.04, try:  sudo apt-get install libxml-simple-perl
+#
+# The tool reads a system configuration (e.g. final_config.xml) and simulates
+# on each CPU the time partition windows, the expiry points of repeating
+# schedule tables driven by hardware counters, and the releases of periodic
+# tasks over the hyperperiod. Within a time partition, tasks are dispatched by
+# fixed priority, each job executing for its configured budget.
+#
+# The report lists per partition the window share and the configured demand,
+# and per task the worst-case release jitter (release to first dispatch),
+# the worst-case response time and the number of missed deadlines.
+#
+# Usage: ab_sched_sim.pl [-s <schedule>] [-t <ns>] final_config.xml [-o <report.txt>]
+#
+# agent, 2026-10-18: initial
+
+
+use strict;
+use warnings "all";
+use XML::Simple;
+
+# tool version ID
+my $VERSION = "ab_sched_sim.pl 2026-10-18";
+
+# global variables
+my $verbose = 0;
+my $tick_ns = 1000000;	# length of a hardware counter tick in ns
+my $max_frames = 1000;	# upper bound of the simulated hyperperiod
+my $schedule_name;
+
+
+################################################################################
+
+# Convert decimal or hex string to number
+sub number
+{
+	$_ = shift;
+	if (substr ($_, 0, 2) eq '0x') {
+		return hex $_;
+	}
+	return int $_;
+}
+
+# Greatest common divisor
+sub gcd
+{
+	my ($x, $y) = @_;
+	while ($y != 0) {
+		($x, $y) = ($y, $x % $y);
+	}
+	return $x;
+}
+
+# Least common multiple
+sub lcm
+{
+	my ($x, $y) = @_;
+	return $x / gcd($x, $y) * $y;
+}
+
+# Format nanoseconds for the report
+sub fmt_ns
+{
+	my $ns = shift;
+	if (!defined $ns) {
+		return "-";
+	}
+	if ($ns >= 1000000) {
+		return sprintf("%.3fms", $ns / 1000000);
+	}
+	return sprintf("%.3fus", $ns / 1000);
+}
+
+# Amount of window time of a time partition in [$from, $to)
+sub supply
+{
+	my ($windows, $from, $to) = @_;
+	my $sum = 0;
+
+	for my $w (@$windows) {
+		my $s = $w->[0] > $from ? $w->[0] : $from;
+		my $e = $w->[1] < $to ? $w->[1] : $to;
+		if ($e > $s) {
+			$sum += $e - $s;
+		}
+	}
+	return $sum;
+}
+
+################################################################################
+
+# Simulate fixed priority scheduling of jobs within the windows of a time
+# partition. Each job is [release, deadline, prio, budget, task].
+# Fills in per task statistics: jobs, jitter, response, misses.
+sub simulate_timepart
+{
+	my ($windows, $jobs, $stats) = @_;
+	my @pending;
+	my $next_job = 0;
+
+	@$jobs = sort { $a->[0] <=> $b->[0] || $b->[2] <=> $a->[2] } @$jobs;
+
+	for my $w (@$windows) {
+		my ($now, $end) = @$w;
+
+		while ($now < $end) {
+			# release all jobs up to now
+			while ($next_job < @$jobs && $jobs->[$next_job][0] <= $now) {
+				my $j = $jobs->[$next_job++];
+				push(@pending, { job => $j, left => $j->[3] });
+			}
+
+			if (@pending == 0) {
+				# idle: skip to the next release
+				if ($next_job < @$jobs && $jobs->[$next_job][0] < $end) {
+					$now = $jobs->[$next_job][0];
+					next;
+				}
+				last;
+			}
+
+			# highest priority pending job, FIFO among same priority
+			my $best = 0;
+			for (my $i = 1; $i < @pending; $i++) {
+				if ($pending[$i]{job}[2] > $pending[$best]{job}[2]) {
+					$best = $i;
+				}
+			}
+			my $p = $pending[$best];
+			my $j = $p->{job};
+			my $st = $stats->{$j->[4]};
+
+			if (!defined $p->{start}) {
+				$p->{start} = $now;
+				my $jitter = $now - $j->[0];
+				if ($jitter > $st->{jitter}) {
+					$st->{jitter} = $jitter;
+				}
+			}
+
+			# run until completion, window end, or the next release
+			my $until = $now + $p->{left};
+			if ($until > $end) {
+				$until = $end;
+			}
+			if ($next_job < @$jobs && $jobs->[$next_job][0] < $until) {
+				$until = $jobs->[$next_job][0];
+			}
+			$p->{left} -= $until - $now;
+			$now = $until;
+
+			if ($p->{left} == 0) {
+				my $response = $now - $j->[0];
+				if ($response > $st->{response}) {
+					$st->{response} = $response;
+				}
+				if (defined $j->[1] && $now > $j->[1]) {
+					$st->{misses}++;
+				}
+				splice(@pending, $best, 1);
+			}
+		}
+	}
+
+	# jobs that never got dispatched or completed within the hyperperiod
+	while ($next_job < @$jobs) {
+		push(@pending, { job => $jobs->[$next_job++] });
+	}
+	for my $p (@pending) {
+		my $st = $stats->{$p->{job}[4]};
+		$st->{unfinished}++;
+		if (defined $p->{job}[1]) {
+			$st->{misses}++;
+		}
+	}
+}
+
+################################################################################
+
+sub usage
+{
+	my $ret = shift;
+	if (!defined $ret) {
+		$ret = 1;
+	}
+
+	print "usage:\n";
+	print "  ab_sched_sim.pl [-h|--help] [--version]\n";
+	print "                  [-v] [-s <schedule>] [-t <ns>] [-n <frames>]\n";
+	print "                  <final_config.xml>\n";
+	print "                  [-o <report.txt>]\n";
+	print "\n";
+	print "options:\n";
+	print "  -h|--help        print this help text and exit\n";
+	print "  --version        print version information and exit\n";
+	print "  -v               verbosity level, increases for each -v\n";
+	print "  -s <schedule>    time partition schedule to simulate (default: first)\n";
+	print "  -t <ns>          hardware counter tick length in ns (default: 1000000)\n";
+	print "  -n <frames>      limit of the hyperperiod in major frames (default: 1000)\n";
+	print "  <config.xml>     system configuration\n";
+	print "  -o <report.txt>  report file to create (default: stdout)\n";
+
+	exit $ret;
+}
+
+################################################################################
+
+my $xmlfile;
+my $reportfile;
+
+while (defined $ARGV[0]) {
+	if ($ARGV[0] eq '--help') {
+		usage(0);
+	} elsif ($ARGV[0] eq '-h') {
+		usage(0);
+	} elsif ($ARGV[0] eq '--version') {
+		print "version: ", $VERSION, "\n";
+		exit 0;
+	} elsif ($ARGV[0] eq '-v') {
+		shift;
+		$verbose++;
+	} elsif ($ARGV[0] eq '-s') {
+		shift;
+		$schedule_name = shift;
+	} elsif ($ARGV[0] eq '-t') {
+		shift;
+		$tick_ns = shift;
+		if (!defined $tick_ns || $tick_ns <= 0) {
+			die "error: invalid tick length\n";
+		}
+	} elsif ($ARGV[0] eq '-n') {
+		shift;
+		$max_frames = shift;
+		if (!defined $max_frames || $max_frames <= 0) {
+			die "error: invalid number of frames\n";
+		}
+	} elsif ($ARGV[0] eq '-o') {
+		shift;
+		$reportfile = shift;
+	} else {
+		if (defined $xmlfile) {
+			die "error: invalid argument '", $ARGV[0], "'\n";
+		}
+		$xmlfile = shift;
+	}
+}
+
+if (!defined $xmlfile) {
+	die "error: no configuration specified\n";
+}
+
+my $all = XMLin($xmlfile,
+				KeyAttr => { },
+				ForceArray => ['partition', 'task', 'isr', 'sched_table', 'expiry',
+				               'action_task', 'schedule', 'window', 'counter'],
+				) or die "opening and parsing failed!\n";
+
+my $sys = $all->{system};
+my $target = $all->{target};
+
+if (!defined $target->{cpus}) {
+	die "target has undefined number of CPUs\n";
+}
+my $num_cpus = number $target->{cpus};
+if (!defined $sys->{period}) {
+	die "system has undefined period\n";
+}
+my $system_period = number $sys->{period};
+
+# hardware counters, other counters aren't time based
+my %hw_counters;
+for my $cnt (@{$sys->{counter}}) {
+	if (defined $cnt->{type} && $cnt->{type} eq "hw") {
+		$hw_counters{$cnt->{name}} = 1;
+	}
+}
+
+# time partition windows: [cpu][timepart] -> list of [offset, duration]
+my @frame;
+{
+	my $schedule;
+	if ($sys->{schedule}) {
+		if (defined $schedule_name) {
+			for my $s (@{$sys->{schedule}}) {
+				if ($s->{name} eq $schedule_name) {
+					$schedule = $s;
+				}
+			}
+			if (!defined $schedule) {
+				die "error: time partition schedule '", $schedule_name, "' not found\n";
+			}
+		} else {
+			$schedule = $sys->{schedule}[0];
+		}
+	} elsif (defined $schedule_name) {
+		die "error: system has no time partition schedules\n";
+	}
+
+	for (my $cpu = 0; $cpu < $num_cpus; $cpu++) {
+		if (!defined $schedule) {
+			# default schedule: time partition 0 spans the full period
+			push(@{$frame[$cpu][0]}, [0, $system_period]);
+			next;
+		}
+		my $start = 0;
+		for my $w (@{$schedule->{window}}) {
+			my $off = number $w->{offset};
+			my $dur = number $w->{duration};
+			if ($off != $start) {
+				die "error: schedule '", $schedule->{name}, "' window at offset ", $off, " overlaps or leaves a hole\n";
+			}
+			push(@{$frame[$cpu][number $w->{timepart}]}, [$off, $dur]);
+			$start += $dur;
+		}
+		if ($start != $system_period) {
+			die "error: schedule '", $schedule->{name}, "' duration ", $start, " does not match system period ", $system_period, "\n";
+		}
+	}
+}
+
+# collect task releases and the hyperperiod
+my $hyperperiod = $system_period;
+my @tasks;		# [name, part, cpu, timepart, prio, budget, capacity, period]
+my %task_by_name;
+my @schedtabs;	# [part name, duration in ns, list of [offset in ns, task name]]
+
+for my $part (@{$sys->{partition}}) {
+	my $cpu = defined $part->{cpu} ? number $part->{cpu} : 0;
+	my $timepart = defined $part->{timepart} ? number $part->{timepart} : 0;
+
+	for my $task (@{$part->{task}}) {
+		my $name = $part->{name} . "::" . $task->{name};
+		my $period = defined $task->{period} ? number $task->{period} : -1;
+		my $capacity = defined $task->{capacity} ? number $task->{capacity} : -1;
+		my $budget = defined $task->{budget} ? number $task->{budget} : 0;
+		my $t = [$name, $part->{name}, $cpu, $timepart, number($task->{prio}),
+		         $budget, $capacity, $period];
+		push(@tasks, $t);
+		$task_by_name{$name} = $t;
+		if ($period > 0) {
+			$hyperperiod = lcm($hyperperiod, $period);
+		}
+	}
+
+	for my $st (@{$part->{sched_table}}) {
+		if (!defined $hw_counters{$st->{counter}}) {
+			print STDERR "warning: schedule table '", $st->{name}, "' not driven by a hardware counter, skipped\n";
+			next;
+		}
+		my $duration = (number $st->{duration}) * $tick_ns;
+		my @actions;
+		for my $exp (@{$st->{expiry}}) {
+			for my $a (@{$exp->{action_task}}) {
+				push(@actions, [(number $exp->{offset}) * $tick_ns, $a->{partition} . "::" . $a->{task}]);
+			}
+		}
+		my $repeating = defined $st->{repeating} && $st->{repeating} eq "yes";
+		push(@schedtabs, [$part->{name}, $duration, \@actions, $repeating]);
+		if ($repeating) {
+			$hyperperiod = lcm($hyperperiod, $duration);
+		}
+	}
+}
+
+if ($hyperperiod > $max_frames * $system_period) {
+	print STDERR "warning: hyperperiod ", fmt_ns($hyperperiod), " truncated to ", $max_frames, " major frames\n";
+	$hyperperiod = $max_frames * $system_period;
+}
+if ($verbose) {
+	print STDERR "simulating ", fmt_ns($hyperperiod), " (", $hyperperiod / $system_period, " major frames)\n";
+}
+
+# jobs per time partition: [cpu][timepart] -> list of jobs
+my @jobs;
+my %stats;
+
+sub add_job
+{
+	my ($t, $release) = @_;
+	my $deadline = $t->[6] > 0 ? $release + $t->[6] : undef;
+
+	push(@{$jobs[$t->[2]][$t->[3]]}, [$release, $deadline, $t->[4], $t->[5], $t->[0]]);
+	$stats{$t->[0]}{jobs}++;
+}
+
+for my $t (@tasks) {
+	$stats{$t->[0]} = { jobs => 0, jitter => 0, response => 0, misses => 0, unfinished => 0 };
+}
+for my $t (@tasks) {
+	if ($t->[7] > 0) {
+		for (my $r = 0; $r < $hyperperiod; $r += $t->[7]) {
+			add_job($t, $r);
+		}
+	}
+}
+for my $st (@schedtabs) {
+	my ($part, $duration, $actions, $repeating) = @$st;
+	for (my $base = 0; $base < $hyperperiod; $base += $duration) {
+		for my $a (@$actions) {
+			my $t = $task_by_name{$a->[1]};
+			if (!defined $t) {
+				die "error: schedule table of partition '", $part, "' activates unknown task '", $a->[1], "'\n";
+			}
+			if ($base + $a->[0] < $hyperperiod) {
+				add_job($t, $base + $a->[0]);
+			}
+		}
+		last if (!$repeating);
+	}
+}
+
+# unroll the windows over two hyperperiods (so that jobs released at the end
+# of the first one can complete) and simulate
+my @windows;	# [cpu][timepart] -> list of [start, end]
+for (my $cpu = 0; $cpu < $num_cpus; $cpu++) {
+	for (my $tp = 0; $tp < @{$frame[$cpu]}; $tp++) {
+		next if (!defined $frame[$cpu][$tp]);
+		for (my $base = 0; $base < 2 * $hyperperiod; $base += $system_period) {
+			for my $w (@{$frame[$cpu][$tp]}) {
+				push(@{$windows[$cpu][$tp]}, [$base + $w->[0], $base + $w->[0] + $w->[1]]);
+			}
+		}
+		@{$windows[$cpu][$tp]} = sort { $a->[0] <=> $b->[0] } @{$windows[$cpu][$tp]};
+	}
+	for (my $tp = 0; defined $jobs[$cpu] && $tp < @{$jobs[$cpu]}; $tp++) {
+		next if (!defined $jobs[$cpu][$tp]);
+		simulate_timepart($windows[$cpu][$tp] || [], $jobs[$cpu][$tp], \%stats);
+	}
+}
+
+################################################################################
+
+my $FILE;
+if (defined $reportfile) {
+	open $FILE, ">$reportfile" or die "Couldn't open $reportfile file for writing, $!\n";
+} else {
+	$FILE = *STDOUT;
+}
+
+printf $FILE "system period %s, hyperperiod %s, %d CPUs\n\n", fmt_ns($system_period), fmt_ns($hyperperiod), $num_cpus;
+
+print $FILE "cpu  tp  partition          window   demand\n";
+my $infeasible = 0;
+for my $part (@{$sys->{partition}}) {
+	my $cpu = defined $part->{cpu} ? number $part->{cpu} : 0;
+	my $tp = defined $part->{timepart} ? number $part->{timepart} : 0;
+	my $supply = 0;
+	if (defined $windows[$cpu][$tp]) {
+		$supply = supply($windows[$cpu][$tp], 0, $hyperperiod);
+	}
+	my $demand = 0;
+	for my $t (@tasks) {
+		next if ($t->[1] ne $part->{name});
+		$demand += $stats{$t->[0]}{jobs} * $t->[5];
+	}
+	printf $FILE "%3d %3d  %-16s  %5.1f%%  %5.1f%%%s\n", $cpu, $tp, $part->{name},
+	       100.0 * $supply / $hyperperiod, 100.0 * $demand / $hyperperiod,
+	       $demand > $supply ? "  OVERLOAD" : "";
+}
+print $FILE "\n";
+
+print $FILE "task                              prio    jobs     jitter   response  deadline\n";
+for my $t (sort { $a->[2] <=> $b->[2] || $a->[3] <=> $b->[3] || $b->[4] <=> $a->[4] } @tasks) {
+	my $st = $stats{$t->[0]};
+	next if ($st->{jobs} == 0);
+	my $result;
+	if ($st->{misses} > 0) {
+		$result = $st->{misses} . " missed";
+		$infeasible = 1;
+	} elsif ($t->[6] > 0) {
+		$result = "ok";
+	} else {
+		$result = "-";
+	}
+	if ($st->{unfinished} > 0) {
+		$result .= " (" . $st->{unfinished} . " unfinished)";
+	}
+	printf $FILE "%-32s  %4d  %6d  %9s  %9s  %s\n", $t->[0], $t->[4], $st->{jobs},
+	       fmt_ns($st->{jitter}), fmt_ns($st->{response}), $result;
+}
+
+if (defined $reportfile) {
+	close($FILE) or die "Couldn't close $reportfile, $!\n";
+}
+
+exit $infeasible;
@@ -0,0 +1,286 @@
+#!/usr/bin/perl -w
+#
+# ab_trace_decode.pl - decode kernel trace buffers into a Chrome trace timeline
+#
+# The kernel must be built with TRACE=yes. Dump the per-CPU trace buffers
+# from the target, e.g. with GDB:
+#
+#   (gdb) dump binary memory trace.bin &trace_buf ((char *)&trace_buf) + sizeof(trace_buf)
+#
+# and convert the dump into JSON that can be loaded into chrome://tracing:
+#
+#   ab_trace_decode.pl -f 600 -c final_config.c trace.bin -o trace.json
+#
+# Usage: ab_trace_decode.pl [-b] [-f <MHz>] [-c <config.c>] <trace.bin> -o <trace.json>
+#
+# agent, 2026-10-18: initial
+
+
+use strict;
+use warnings "all";
+
+# tool version ID
+my $VERSION = "ab_trace_decode.pl 2026-10-18";
+
+# keep in sync with kernel/include/trace.h
+my $TRACE_MAGIC = 0x54524331;
+my $TRACE_HDR_SIZE = 16;
+my @TRACE_EV_NAMES = ("none", "switch", "irq_entry", "irq_exit", "syscall",
+                      "tp_switch", "ipi_send", "ipi_recv");
+
+# global variables
+my $verbose = 0;
+my $bigendian = 0;
+my $mhz = 1;
+my @task_names;
+
+
+################################################################################
+
+# Read a file into a buffer
+sub readbin
+{
+	my $filename = shift;
+	my $buffer;
+	my $FILE;
+
+	open($FILE, "<$filename") or die "Couldn't open $filename file for reading, $!\n";
+	binmode($FILE);
+	my $filesize = -s $filename;
+	my $n = sysread($FILE, $buffer, $filesize);
+	if ($n != $filesize) {
+		die "Couldn't read $filename properly, $!\n";
+	}
+	close($FILE) or die "Couldn't close $filename, $!\n";
+
+	return $buffer;
+}
+
+# Extract task names in global task ID order from a generated config.c
+sub read_task_names
+{
+	my $filename = shift;
+	my $FILE;
+	my $in_tasks = 0;
+
+	open($FILE, "<$filename") or die "Couldn't open $filename file for reading, $!\n";
+	while (<$FILE>) {
+		if (/^const struct task_cfg task_cfg\[/) {
+			$in_tasks = 1;
+		} elsif ($in_tasks && /^};/) {
+			last;
+		} elsif ($in_tasks && /\.name = "(.*)"/) {
+			push(@task_names, $1);
+		}
+	}
+	close($FILE) or die "Couldn't close $filename, $!\n";
+}
+
+# Return printable task name for a global task ID
+sub task_name
+{
+	my $id = shift;
+	if (defined $task_names[$id]) {
+		return $task_names[$id];
+	}
+	return "task $id";
+}
+
+# Convert cycles to microseconds (as expected by the trace viewer)
+sub usec
+{
+	return sprintf("%.3f", (shift) / $mhz);
+}
+
+# Quote a string for JSON
+sub quote
+{
+	my $s = shift;
+	$s =~ s/(["\\])/\\$1/g;
+	return "\"$s\"";
+}
+
+################################################################################
+
+sub usage
+{
+	my $ret = shift;
+	if (!defined $ret) {
+		$ret = 1;
+	}
+
+	print "usage:\n";
+	print "  ab_trace_decode.pl [-h|--help] [--version]\n";
+	print "                     [-v] [-b] [-f <MHz>]\n";
+	print "                     [-c <config.c>]\n";
+	print "                     <trace.bin>\n";
+	print "                     -o <trace.json>\n";
+	print "\n";
+	print "options:\n";
+	print "  -h|--help       print this help text and exit\n";
+	print "  --version       print version information and exit\n";
+	print "  -v              verbosity level, increases for each -v\n";
+	print "  -b              trace dump is big endian (PowerPC)\n";
+	print "  -f <MHz>        cycle counter frequency in MHz (default: 1)\n";
+	print "  -c <config.c>   generated kernel config (for task names)\n";
+	print "  <trace.bin>     binary dump of the kernel's trace_buf[]\n";
+	print "  -o <trace.json> Chrome trace event file to create\n";
+
+	exit $ret;
+}
+
+################################################################################
+
+my $binfile;
+my $jsonfile;
+
+while (defined $ARGV[0]) {
+	if ($ARGV[0] eq '--help') {
+		usage(0);
+	} elsif ($ARGV[0] eq '-h') {
+		usage(0);
+	} elsif ($ARGV[0] eq '--version') {
+		print "version: ", $VERSION, "\n";
+		exit 0;
+	} elsif ($ARGV[0] eq '-v') {
+		shift;
+		$verbose++;
+	} elsif ($ARGV[0] eq '-b') {
+		shift;
+		$bigendian = 1;
+	} elsif ($ARGV[0] eq '-f') {
+		shift;
+		$mhz = shift;
+		if (!defined $mhz || $mhz <= 0) {
+			die "error: invalid frequency\n";
+		}
+	} elsif ($ARGV[0] eq '-c') {
+		shift;
+		read_task_names(shift);
+	} elsif ($ARGV[0] eq '-o') {
+		shift;
+		$jsonfile = shift;
+	} else {
+		if (defined $binfile) {
+			die "error: invalid argument '", $ARGV[0], "'\n";
+		}
+		$binfile = shift;
+	}
+}
+
+if (!defined $binfile) {
+	die "error: no trace dump specified\n";
+}
+
+if (!defined $jsonfile) {
+	die "error: no output file specified\n";
+}
+
+my $u32 = $bigendian ? "N" : "V";
+my $u16 = $bigendian ? "n" : "v";
+my $buffer = readbin($binfile);
+my $offset = 0;
+my @json;
+
+# walk the per-CPU trace buffers
+while ($offset + $TRACE_HDR_SIZE <= length($buffer)) {
+	my ($magic, $num_events, $event_size, $count) =
+		unpack("\@$offset $u32 $u16 $u16 $u32", $buffer);
+
+	if ($magic != $TRACE_MAGIC) {
+		# unused or uninitialized buffer
+		last;
+	}
+	if ($event_size != 16 || $num_events == 0) {
+		die "error: invalid trace buffer header at offset $offset\n";
+	}
+
+	my $events = $offset + $TRACE_HDR_SIZE;
+	my $first = 0;
+	my $n = $count;
+	if ($count > $num_events) {
+		$first = $count % $num_events;
+		$n = $num_events;
+	}
+	if ($verbose) {
+		print "buffer at offset $offset: $count events recorded, $n available\n";
+	}
+
+	my $cpu;
+	my $now = 0;
+	my $last_ts;
+	my $switch_ts;
+	my $switch_task;
+	my $tp_ts;
+	my $tp_id;
+
+	for (my $i = 0; $i < $n; $i++) {
+		my $pos = $events + (($first + $i) % $num_events) * $event_size;
+		my ($ts, $type, $ev_cpu, $arg0, $arg1, $arg2) =
+			unpack("\@$pos $u32 C C $u16 $u32 $u32", $buffer);
+
+		# unwrap the 32-bit cycle counter
+		if (defined $last_ts) {
+			$now += ($ts - $last_ts) & 0xffffffff;
+		}
+		$last_ts = $ts;
+		$cpu = $ev_cpu;
+
+		my $name = defined $TRACE_EV_NAMES[$type] ? $TRACE_EV_NAMES[$type] : "event $type";
+		my $t = usec($now);
+
+		if ($name eq "switch") {
+			if (defined $switch_ts) {
+				push(@json, "{\"name\":" . quote(task_name($switch_task)) . ",\"ph\":\"X\",\"pid\":$cpu,\"tid\":0,\"ts\":" . usec($switch_ts) . ",\"dur\":" . usec($now - $switch_ts) . "}");
+			}
+			$switch_ts = $now;
+			$switch_task = $arg2;
+		} elsif ($name eq "irq_entry") {
+			push(@json, "{\"name\":\"irq $arg1\",\"ph\":\"B\",\"pid\":$cpu,\"tid\":1,\"ts\":$t}");
+		} elsif ($name eq "irq_exit") {
+			push(@json, "{\"name\":\"irq $arg1\",\"ph\":\"E\",\"pid\":$cpu,\"tid\":1,\"ts\":$t}");
+		} elsif ($name eq "tp_switch") {
+			if (defined $tp_ts) {
+				push(@json, "{\"name\":\"tp $tp_id\",\"ph\":\"X\",\"pid\":$cpu,\"tid\":2,\"ts\":" . usec($tp_ts) . ",\"dur\":" . usec($now - $tp_ts) . "}");
+			}
+			$tp_ts = $now;
+			$tp_id = $arg2;
+		} elsif ($name eq "syscall") {
+			push(@json, "{\"name\":\"syscall $arg1\",\"ph\":\"i\",\"s\":\"t\",\"pid\":$cpu,\"tid\":0,\"ts\":$t}");
+		} elsif ($name eq "ipi_send") {
+			push(@json, "{\"name\":\"ipi send\",\"ph\":\"i\",\"s\":\"p\",\"pid\":$cpu,\"tid\":0,\"ts\":$t,\"args\":{\"mask\":$arg1}}");
+		} elsif ($name eq "ipi_recv") {
+			push(@json, "{\"name\":\"ipi recv\",\"ph\":\"i\",\"s\":\"p\",\"pid\":$cpu,\"tid\":0,\"ts\":$t,\"args\":{\"source\":$arg1}}");
+		}
+	}
+
+	if (defined $cpu) {
+		# close open spans at the last recorded event
+		if (defined $switch_ts && $now > $switch_ts) {
+			push(@json, "{\"name\":" . quote(task_name($switch_task)) . ",\"ph\":\"X\",\"pid\":$cpu,\"tid\":0,\"ts\":" . usec($switch_ts) . ",\"dur\":" . usec($now - $switch_ts) . "}");
+		}
+		if (defined $tp_ts && $now > $tp_ts) {
+			push(@json, "{\"name\":\"tp $tp_id\",\"ph\":\"X\",\"pid\":$cpu,\"tid\":2,\"ts\":" . usec($tp_ts) . ",\"dur\":" . usec($now - $tp_ts) . "}");
+		}
+
+		push(@json, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":$cpu,\"args\":{\"name\":\"cpu $cpu\"}}");
+		push(@json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":$cpu,\"tid\":0,\"args\":{\"name\":\"tasks\"}}");
+		push(@json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":$cpu,\"tid\":1,\"args\":{\"name\":\"interrupts\"}}");
+		push(@json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":$cpu,\"tid\":2,\"args\":{\"name\":\"time partitions\"}}");
+	}
+
+	$offset = $events + $num_events * $event_size;
+}
+
+if (@json == 0) {
+	die "error: no valid trace buffer found in $binfile\n";
+}
+
+{
+	my $FILE;
+	open $FILE, ">$jsonfile" or die "Couldn't open $jsonfile file for writing, $!\n";
+	print $FILE "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+	print $FILE join(",\n", @json), "\n";
+	print $FILE "]}\n";
+	close($FILE) or die "Couldn't close $jsonfile, $!\n";
+}